@@ -0,0 +1,1242 @@
+// FILE: Assign03Extra.cpp
+// A non-interactive test program for the extensions of the sequence class
+// (see Sequence.h) and for the classes built on it.
+//
+// DESCRIPTION:
+// Each function of this program tests part of these classes, returning
+// some number of points to indicate how much of the test was passed.
+// A description and result of each test is printed to cout.
+// Maximum number of points awarded by this program is determined by the
+// constants POINTS[1], POINTS[2]...
+
+#include <iostream>              // provides cout.
+#include <algorithm>             // provides std::sort, std::equal, std::min.
+#include <cstdio>                // provides FILE, fopen, fwrite, remove.
+#include <cstdlib>               // provides size_t, rand, srand.
+#include <cmath>                 // provides fabs.
+#include <functional>            // provides std::greater.
+#include <atomic>                // provides std::atomic.
+#include <thread>                // provides std::thread.
+#include <utility>               // provides std::move.
+#include <vector>                // provides std::vector.
+#include "Sequence.h"            // provides the sequence class.
+#include "BlockSequence.h"       // provides the block_sequence class.
+#include "SortedSequence.h"      // provides the sorted_sequence class.
+#include "ConcurrentSequence.h"  // provides the concurrent_sequence class.
+using namespace std;
+using namespace CS3358_FA2021;
+
+// Descriptions and points for each of the tests:
+const size_t MANY_TESTS = 10;
+const int POINTS[MANY_TESTS+1] =
+{
+    28,  // Total points for all tests.
+     2,  // Test 1 points
+     3,  // Test 2 points
+     3,  // Test 3 points
+     4,  // Test 4 points
+     3,  // Test 5 points
+     3,  // Test 6 points
+     2,  // Test 7 points
+     3,  // Test 8 points
+     3,  // Test 9 points
+     2   // Test 10 points
+};
+const char DESCRIPTION[MANY_TESTS+1][256] =
+{
+    "tests for the sequence extensions and variants",
+    "Testing large (mapped) sequences",
+    "Testing the reduction member functions",
+    "Testing concurrent_sequence publish and snapshots",
+    "Testing block_sequence against sequence",
+    "Testing sorted_sequence",
+    "Testing save and load",
+    "Testing begin, end and data with standard algorithms",
+    "Testing the range insertions and removals against a model",
+    "Testing moves, swap, reserve and shrink_to_fit",
+    "Testing sequence::cursor"
+};
+
+// Name of the scratch file used by the save and load tests.
+const char SCRATCH_FILE[] = "a3extra.seq";
+
+
+// **************************************************************************
+// bool same_items(const sequence& test, const double items[], size_t s)
+//   Postcondition: The return value is true if test has exactly s items
+//   and they are equal to items[0] ... items[s-1]; otherwise false.
+//   The cursor of test is not moved.
+// **************************************************************************
+bool same_items(const sequence& test, const double items[], size_t s)
+{
+    if (test.size() != s)
+        return false;
+    for (size_t i = 0; i < s; i++)
+        if (test.data()[i] != items[i])
+            return false;
+    return true;
+}
+
+
+// **************************************************************************
+// bool counts_up(const sequence& test)
+//   Postcondition: The return value is true if the items of test are
+//   0, 1, 2, ..., test.size()-1; otherwise false.
+// **************************************************************************
+bool counts_up(const sequence& test)
+{
+    for (size_t i = 0; i < test.size(); i++)
+        if (test.data()[i] != i)
+            return false;
+    return true;
+}
+
+
+// **************************************************************************
+// bool same_sequence(block_sequence& test, sequence& model)
+//   Postcondition: The return value is true if test and model hold the same
+//   items in the same order and have the current item at the same place.
+//   NOTE: The cursors of both sequences are moved back to the start, then
+//   off the end of the sequence.
+// **************************************************************************
+bool same_sequence(block_sequence& test, sequence& model)
+{
+    if (test.size() != model.size() || test.is_item() != model.is_item())
+        return false;
+    if (test.is_item() && test.current() != model.current())
+        return false;
+
+    test.start();
+    model.start();
+    while (test.is_item() && model.is_item())
+    {
+        if (test.current() != model.current())
+            return false;
+        test.advance();
+        model.advance();
+    }
+    return !test.is_item() && !model.is_item();
+}
+
+
+// **************************************************************************
+// bool patch_file(const char path[], long offset, const void* bytes, size_t n)
+//   Postcondition: n bytes at the given offset of the file named path have
+//   been overwritten with bytes, and the return value is true (false if the
+//   file could not be changed).
+// **************************************************************************
+bool patch_file(const char path[], long offset, const void* bytes, size_t n)
+{
+    FILE* file = fopen(path, "r+b");
+    if (file == 0)
+        return false;
+    bool answer = (fseek(file, offset, SEEK_SET) == 0)
+                  && (fwrite(bytes, 1, n, file) == n);
+    return (fclose(file) == 0) && answer;
+}
+
+
+// **************************************************************************
+// bool matches_model(const sequence& test, const vector<double>& model,
+//                    size_t model_current)
+//   Precondition: The items of model are all different.
+//   Postcondition: The return value is true if test holds the items of
+//   model in the same order and its current item is model[model_current]
+//   (or it has no current item, if model_current == model.size());
+//   otherwise false. The cursor of test is not moved.
+// **************************************************************************
+bool matches_model(const sequence& test, const vector<double>& model,
+                   size_t model_current)
+{
+    if (test.size() != model.size()
+        || !equal(model.begin(), model.end(), test.data()))
+        return false;
+    if (model_current == model.size())
+        return !test.is_item();
+    return test.is_item() && test.current() == model[model_current];
+}
+
+
+// **************************************************************************
+// int test1()
+//   Grows a sequence past LARGE_ARRAY_BYTES, removes most of it and shrinks
+//   it, checking the items survive each step.
+//   Returns POINTS[1] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test1()
+{
+    const size_t MANY = sequence::LARGE_ARRAY_BYTES / sizeof(double) + 1000;
+    const size_t KEEP = 1000;
+    sequence test;
+    size_t i;
+
+    cout << "Attaching " << MANY << " items one at a time ...";
+    cout.flush();
+    for (i = 0; i < MANY; i++)
+        test.attach(i);
+    if (!counts_up(test) || test.size() != MANY)
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Removing all but the first " << KEEP << " items and calling\n";
+    cout << "shrink_to_fit ...";
+    cout.flush();
+    test.move_to(KEEP);
+    test.remove_range(MANY);
+    test.shrink_to_fit();
+    if (test.is_item() || !counts_up(test) || test.size() != KEEP)
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Copying into a larger sequence and growing again ...";
+    cout.flush();
+    sequence copy(MANY);
+    copy.attach(-1);
+    copy = test;
+    for (i = KEEP; i < 2 * KEEP; i++)
+        copy.attach(i);
+    if (!counts_up(copy) || copy.size() != 2 * KEEP || !counts_up(test))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this first function have been passed." << endl;
+    return POINTS[1];
+}
+
+
+// **************************************************************************
+// int test2()
+//   Checks sum, mean, min, max, variance and dot on a short sequence and on
+//   one long enough to be split across threads.
+//   Returns POINTS[2] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test2()
+{
+    double items[6] = { 2, 4, 4, 4, 5, 5 };
+    sequence test;
+    sequence ones;
+    size_t i;
+
+    cout << "Testing the reductions of 2, 4, 4, 4, 5, 5 ...";
+    cout.flush();
+    test.attach_range(items, items + 6);
+    for (i = 0; i < 6; i++)
+        ones.attach(1);
+    if (sequence().sum() != 0 || test.sum() != 24 || test.mean() != 4
+        || test.min() != 2 || test.max() != 5
+        || fabs(test.variance() - 1.0) > 1e-12 || test.dot(ones) != 24)
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    const size_t MANY = 3 * sequence::PARALLEL_CUTOFF + 5;
+    cout << "Testing the reductions of 0, 1, 2, ..., " << MANY - 1 << " ...";
+    cout.flush();
+    sequence big(MANY);
+    sequence twos(MANY);
+    for (i = 0; i < MANY; i++)
+    {
+        big.attach(i);
+        twos.attach(2);
+    }
+    double n = MANY;
+    if (big.sum() != n * (n - 1) / 2 || big.mean() != (n - 1) / 2
+        || big.min() != 0 || big.max() != n - 1
+        || fabs(big.variance() - (n * n - 1) / 12) > 1e-9 * n * n
+        || big.dot(twos) != n * (n - 1))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this second function have been passed." << endl;
+    return POINTS[2];
+}
+
+
+// **************************************************************************
+// int test3()
+//   Checks that a snapshot is unchanged by later edits and publishes, then
+//   runs reader threads against a publishing writer and checks that every
+//   snapshot they see is a complete published version.
+//   Returns POINTS[3] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test3()
+{
+    const size_t READERS = 3;
+    const size_t PUBLISHES = 2000;
+    concurrent_sequence test;
+    size_t i;
+
+    cout << "Publishing 0, 1, 2 and taking a snapshot ...";
+    cout.flush();
+    if (test.read()->size() != 0)
+    {
+        cout << " the first snapshot is not empty." << endl;
+        return 0;
+    }
+    for (i = 0; i < 3; i++)
+        test.working().attach(i);
+    test.publish();
+    concurrent_sequence::snapshot first = test.read();
+    cout << " passed." << endl;
+
+    cout << "Editing and publishing again; the snapshot must not change ...";
+    cout.flush();
+    test.working().start();
+    test.working().remove_current();
+    test.working().attach(7);
+    test.publish();
+    test.publish();
+    if (first->size() != 3 || !counts_up(*first)
+        || test.read()->size() != 3 || test.read()->data()[1] != 7)
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    first.reset();
+    cout << " passed." << endl;
+
+    cout << "Running " << READERS << " reader threads during ";
+    cout << PUBLISHES << " publishes ...";
+    cout.flush();
+    sequence& draft = test.working();
+    draft = sequence();
+    test.publish();
+
+    atomic<bool> done(false);
+    atomic<int> bad(0);
+    vector<thread> readers;
+    for (i = 0; i < READERS; i++)
+        readers.push_back(thread([&test, &done, &bad]()
+        {
+            size_t last = 0;
+            while (!done.load())
+            {
+                concurrent_sequence::snapshot s = test.read();
+                if (!counts_up(*s) || s->size() < last)
+                    ++bad;
+                last = s->size();
+            }
+        }));
+    for (i = 0; i < PUBLISHES; i++)
+    {
+        draft.attach(i);
+        test.publish();
+    }
+    done.store(true);
+    for (i = 0; i < READERS; i++)
+        readers[i].join();
+    if (bad.load() != 0 || test.read()->size() != PUBLISHES
+        || !counts_up(*test.read()))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this third function have been passed." << endl;
+    return POINTS[3];
+}
+
+
+// **************************************************************************
+// int test4()
+//   Applies the same inserts, attaches and removals to a block_sequence and
+//   a sequence, enough of them to split, free and merge blocks, and checks
+//   the two agree. Returns POINTS[4] if the tests are passed. Otherwise
+//   returns 0.
+// **************************************************************************
+int test4()
+{
+    const size_t MANY = 3 * block_sequence::BLOCK_CAPACITY + 7;
+    block_sequence test;
+    sequence model;
+    size_t i;
+
+    cout << "Attaching " << MANY << " items to a block_sequence and a sequence ...";
+    cout.flush();
+    for (i = 0; i < MANY; i++)
+    {
+        test.attach(i);
+        model.attach(i);
+    }
+    if (!same_sequence(test, model))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Inserting an item in front of every third item ...";
+    cout.flush();
+    test.start();
+    model.start();
+    for (i = 0; test.is_item(); i++)
+    {
+        if (i % 3 == 0)
+        {
+            test.insert(-1.0 * i);
+            model.insert(-1.0 * i);
+            test.advance();
+            model.advance();
+        }
+        test.advance();
+        model.advance();
+    }
+    if (!same_sequence(test, model))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Removing all but every tenth item ...";
+    cout.flush();
+    test.start();
+    model.start();
+    for (i = 0; test.is_item(); i++)
+    {
+        if (i % 10 == 0)
+        {
+            test.advance();
+            model.advance();
+        }
+        else
+        {
+            test.remove_current();
+            model.remove_current();
+        }
+    }
+    if (!same_sequence(test, model))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Testing the copy constructor, assignment and move ...";
+    cout.flush();
+    block_sequence copy(test);
+    block_sequence assigned;
+    assigned.attach(99);
+    assigned = copy;
+    block_sequence moved(std::move(copy));
+    if (!same_sequence(assigned, model) || !same_sequence(moved, model))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Removing every item ...";
+    cout.flush();
+    test.start();
+    model.start();
+    while (test.is_item())
+    {
+        test.remove_current();
+        model.remove_current();
+    }
+    if (test.size() != 0 || !same_sequence(test, model))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this fourth function have been passed." << endl;
+    return POINTS[4];
+}
+
+
+// **************************************************************************
+// int test5()
+//   Performs tests of sorted_sequence's insert, find, lower_bound and merge.
+//   Returns POINTS[5] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test5()
+{
+    double input[8] = { 50, 10, 40, 20, 40, 60, 30, 10 };
+    double sorted[8] = { 10, 10, 20, 30, 40, 40, 50, 60 };
+    double merged[12] = { 5, 10, 10, 20, 30, 40, 40, 40, 50, 60, 60, 70 };
+    sorted_sequence test;
+    sorted_sequence other;
+    size_t i;
+
+    cout << "Inserting 50, 10, 40, 20, 40, 60, 30, 10 ...";
+    cout.flush();
+    for (i = 0; i < 8; i++)
+    {
+        test.insert(input[i]);
+        if (!test.is_item() || test.current() != input[i])
+        {
+            cout << " the inserted item was not made current." << endl;
+            return 0;
+        }
+    }
+    if (!same_items(test.items(), sorted, 8))
+    {
+        cout << " the items are not in ascending order." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Testing find for present and missing items ...";
+    cout.flush();
+    if (!test.find(40) || test.current() != 40)
+    {
+        cout << " failed to find 40." << endl;
+        return 0;
+    }
+    test.advance();
+    test.advance();
+    if (!test.is_item() || test.current() != 50)
+    {
+        cout << " find did not move to the first 40." << endl;
+        return 0;
+    }
+    if (test.find(35) || test.is_item())
+    {
+        cout << " found 35, which is not in the sequence." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Testing lower_bound ...";
+    cout.flush();
+    if (!test.lower_bound(35) || test.current() != 40
+        || !test.lower_bound(5) || test.current() != 10
+        || test.lower_bound(65) || test.is_item())
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Merging 5, 40, 60, 70 into the sequence ...";
+    cout.flush();
+    other.insert(70);
+    other.insert(40);
+    other.insert(5);
+    other.insert(60);
+    test.merge(other);
+    if (test.is_item() || !same_items(test.items(), merged, 12))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this fifth function have been passed." << endl;
+    return POINTS[5];
+}
+
+
+// **************************************************************************
+// int test6()
+//   Saves a sequence, loads it back, saves it again over the file it was
+//   loaded from, and checks that damaged files are refused.
+//   Returns POINTS[6] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test6()
+{
+    double items[5] = { 1.5, -2, 3.25, 4, 1e10 };
+    double other[1] = { 9 };
+    sequence test;
+    sequence loaded;
+    sequence probe;
+    size_t i;
+
+    cout << "Saving 1.5, -2, 3.25, 4, 1e10 with the cursor at [2] ...";
+    cout.flush();
+    for (i = 0; i < 5; i++)
+        test.attach(items[i]);
+    test.move_to(2);
+    if (!test.save(SCRATCH_FILE))
+    {
+        cout << " save failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Loading it into another sequence ...";
+    cout.flush();
+    if (!loaded.load(SCRATCH_FILE) || !same_items(loaded, items, 5)
+        || !loaded.is_item() || loaded.current() != 3.25)
+    {
+        cout << " failed." << endl;
+        remove(SCRATCH_FILE);
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Editing the loaded sequence and saving it over its own file ...";
+    cout.flush();
+    loaded.remove_current();
+    items[2] = items[3];
+    items[3] = items[4];
+    if (!loaded.save(SCRATCH_FILE) || !same_items(loaded, items, 4)
+        || !test.load(SCRATCH_FILE) || !same_items(test, items, 4)
+        || test.current() != 4)
+    {
+        cout << " failed." << endl;
+        remove(SCRATCH_FILE);
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    // test now maps the file, so a fresh sequence checks the damaged ones
+    cout << "Loading a file with a damaged item ...";
+    cout.flush();
+    double damage = 5;
+    probe.attach(other[0]);
+    if (!loaded.save(SCRATCH_FILE)
+        || !patch_file(SCRATCH_FILE, 64, &damage, sizeof(damage))
+        || probe.load(SCRATCH_FILE) || !same_items(probe, other, 1))
+    {
+        cout << " the damaged file was not refused." << endl;
+        remove(SCRATCH_FILE);
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Loading a file whose item count does not fit the file ...";
+    cout.flush();
+    unsigned long long count = (1ULL << 61) + 4;
+    if (!loaded.save(SCRATCH_FILE)
+        || !patch_file(SCRATCH_FILE, 16, &count, sizeof(count))
+        || probe.load(SCRATCH_FILE, false) || !same_items(probe, other, 1))
+    {
+        cout << " the file was not refused." << endl;
+        remove(SCRATCH_FILE);
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    remove(SCRATCH_FILE);
+
+    // All tests passed
+    cout << "All tests of this sixth function have been passed." << endl;
+    return POINTS[6];
+}
+
+
+// **************************************************************************
+// int test7()
+//   Performs tests of begin, end and data by running standard algorithms
+//   over the items of a sequence.
+//   Returns POINTS[7] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test7()
+{
+    double input[6] = { 50, 10, 40, 20, 60, 30 };
+    double sorted[6] = { 10, 20, 30, 40, 50, 60 };
+    double reversed[6] = { 60, 50, 40, 30, 20, 10 };
+    sequence test(2);
+    size_t i;
+
+    cout << "Sorting 50, 10, 40, 20, 60, 30 with std::sort(begin(), end()) ...";
+    cout.flush();
+    for (i = 0; i < 6; i++)
+        test.attach(input[i]);
+    test.start();
+    test.advance();
+    test.advance();
+    sort(test.begin(), test.end());
+    if (!same_items(test, sorted, 6) || test.end() - test.begin() != 6)
+    {
+        cout << " the items are not in ascending order." << endl;
+        return 0;
+    }
+    if (!test.is_item() || test.current() != 30)
+    {
+        cout << " the current index moved." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Sorting descending with std::sort(data(), data() + size()) ...";
+    cout.flush();
+    sort(test.data(), test.data() + test.size(), greater<double>());
+    if (!same_items(test, reversed, 6) || test.current() != 40)
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Comparing the const iterators with std::equal ...";
+    cout.flush();
+    const sequence& view = test;
+    if (!equal(view.begin(), view.end(), reversed)
+        || !equal(test.cbegin(), test.cend(), view.data())
+        || view.begin() != view.data())
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Testing begin() == end() on an empty sequence ...";
+    cout.flush();
+    sequence empty;
+    sort(empty.begin(), empty.end());
+    if (empty.begin() != empty.end() || empty.size() != 0)
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this seventh function have been passed." << endl;
+    return POINTS[7];
+}
+
+
+// **************************************************************************
+// int test8()
+//   Performs tests of insert_range, attach_range, remove_range and
+//   remove_if, with and without a current item, checking the items and
+//   the current item against a vector model.
+//   Returns POINTS[8] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test8()
+{
+    const size_t OPERATIONS = 2000;
+    double range[3] = { 7, 8, 9 };
+    double next_item = 100;   // every item added is different
+    sequence test(2);
+    vector<double> model;
+    size_t model_current = 0;
+    size_t i;
+
+    cout << "Inserting 7, 8, 9 before the 2 of 1, 2, 3, 4 ...";
+    cout.flush();
+    for (i = 1; i <= 4; i++)
+        test.attach(i);
+    test.start();
+    test.advance();
+    test.insert_range(range, range + 3);
+    double expect1[7] = { 1, 7, 8, 9, 2, 3, 4 };
+    model.assign(expect1, expect1 + 7);
+    if (!matches_model(test, model, 1))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Attaching 7, 8, 9 after the 8 ...";
+    cout.flush();
+    test.advance();
+    test.attach_range(range, range + 3);
+    double expect2[10] = { 1, 7, 8, 7, 8, 9, 9, 2, 3, 4 };
+    if (test.size() != 10 || !equal(expect2, expect2 + 10, test.data())
+        || !test.is_item() || test.current() != 9)
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    test.advance();   // the last inserted 9 is followed by the old 9
+    if (!test.is_item() || test.current() != 9)
+    {
+        cout << " the last inserted item is not the current item." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Inserting and attaching with no current item ...";
+    cout.flush();
+    sequence ends;
+    ends.attach(1);
+    ends.attach(2);
+    ends.advance();
+    ends.insert_range(range, range + 2);
+    double expect3[4] = { 7, 8, 1, 2 };
+    model.assign(expect3, expect3 + 4);
+    if (!matches_model(ends, model, 0))
+    {
+        cout << " insert_range did not insert at the front." << endl;
+        return 0;
+    }
+    ends.move_to(ends.size());
+    ends.attach_range(range + 2, range + 3);
+    model.push_back(9);
+    if (!matches_model(ends, model, 4))
+    {
+        cout << " attach_range did not attach at the end." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Testing empty ranges ...";
+    cout.flush();
+    ends.start();
+    ends.insert_range(range, range);
+    ends.attach_range(range, range);
+    if (!matches_model(ends, model, 0))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Removing ranges in the middle and past the end ...";
+    cout.flush();
+    sequence cut;
+    for (i = 1; i <= 8; i++)
+        cut.attach(i);
+    cut.move_to(2);
+    cut.remove_range(3);
+    double expect4[5] = { 1, 2, 6, 7, 8 };
+    model.assign(expect4, expect4 + 5);
+    if (!matches_model(cut, model, 2))
+    {
+        cout << " remove_range(3) failed." << endl;
+        return 0;
+    }
+    cut.advance();
+    cut.remove_range(10);
+    model.resize(3);
+    if (!matches_model(cut, model, 3))
+    {
+        cout << " remove_range(10) failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Removing the even items with remove_if ...";
+    cout.flush();
+    sequence odd;
+    for (i = 1; i <= 9; i++)
+        odd.attach(i);
+    odd.move_to(3);   // the 4, which is removed
+    if (odd.remove_if([](double x) { return int(x) % 2 == 0; }) != 4)
+    {
+        cout << " remove_if did not return 4." << endl;
+        return 0;
+    }
+    double expect5[5] = { 1, 3, 5, 7, 9 };
+    model.assign(expect5, expect5 + 5);
+    if (!matches_model(odd, model, 2))
+    {
+        cout << " failed with the current item removed." << endl;
+        return 0;
+    }
+    odd.move_to(odd.size());
+    if (odd.remove_if([](double x) { return x > 6; }) != 2
+        || !matches_model(odd, vector<double>(expect5, expect5 + 3), 3))
+    {
+        cout << " failed with no current item." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Comparing " << OPERATIONS << " random range operations with a model ...";
+    cout.flush();
+    sequence random(1);
+    model.clear();
+    model_current = 0;
+    srand(3358);
+    for (i = 0; i < OPERATIONS; i++)
+    {
+        vector<double> items(rand() % 5);
+        for (size_t j = 0; j < items.size(); j++)
+            items[j] = next_item++;
+        size_t pos;
+        switch (rand() % 5)
+        {
+        case 0:
+            random.insert_range(items.begin(), items.end());
+            pos = (model_current == model.size()) ? 0 : model_current;
+            model.insert(model.begin() + pos, items.begin(), items.end());
+            if (!items.empty())
+                model_current = pos;
+            break;
+        case 1:
+            random.attach_range(items.begin(), items.end());
+            pos = (model_current == model.size()) ? model.size()
+                                                  : model_current + 1;
+            model.insert(model.begin() + pos, items.begin(), items.end());
+            if (!items.empty())
+                model_current = pos + items.size() - 1;
+            break;
+        case 2:
+            if (random.is_item())
+            {
+                size_t count = rand() % 6;
+                random.remove_range(count);
+                count = min(count, model.size() - model_current);
+                model.erase(model.begin() + model_current,
+                            model.begin() + model_current + count);
+            }
+            break;
+        case 3:
+        {
+            int divisor = 2 + rand() % 5;
+            size_t kept = 0, removed;
+            bool found = false;
+            removed = random.remove_if([divisor](double x)
+                                       { return int(x) % divisor == 0; });
+            for (size_t j = 0; j < model.size(); j++)
+                if (int(model[j]) % divisor != 0)
+                {
+                    if (j >= model_current && !found)
+                    {
+                        found = true;
+                        model_current = kept;
+                    }
+                    model[kept++] = model[j];
+                }
+            if (removed != model.size() - kept)
+            {
+                cout << " remove_if returned the wrong count." << endl;
+                return 0;
+            }
+            model.resize(kept);
+            if (!found)
+                model_current = kept;
+            break;
+        }
+        default:
+            pos = rand() % (model.size() + 1);
+            random.move_to(pos);
+            model_current = pos;
+        }
+        if (!matches_model(random, model, model_current))
+        {
+            cout << " failed at operation " << i << "." << endl;
+            return 0;
+        }
+    }
+    cout << " passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this eighth function have been passed." << endl;
+    return POINTS[8];
+}
+
+
+// **************************************************************************
+// int test9()
+//   Performs tests of the move constructor, move assignment, swap, reserve
+//   and shrink_to_fit, including the use of a moved-from sequence.
+//   Returns POINTS[9] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test9()
+{
+    double items[4] = { 10, 20, 30, 40 };
+    double other_items[2] = { 5, 6 };
+    sequence source;
+    size_t i;
+
+    cout << "Move constructing from a sequence of 10, 20, 30, 40 ...";
+    cout.flush();
+    for (i = 0; i < 4; i++)
+        source.attach(items[i]);
+    source.start();
+    source.advance();
+    const double* array = source.data();
+    sequence moved(std::move(source));
+    if (!same_items(moved, items, 4) || moved.data() != array
+        || !moved.is_item() || moved.current() != 20)
+    {
+        cout << " the items or the current item were not taken over." << endl;
+        return 0;
+    }
+    if (source.size() != 0 || source.is_item() || source.data() != 0)
+    {
+        cout << " the moved-from sequence is not empty." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Using the moved-from sequence (copy, assign, insert) ...";
+    cout.flush();
+    sequence copy_of_empty(source);
+    sequence assigned_empty;
+    assigned_empty.attach(1);
+    assigned_empty = source;
+    if (copy_of_empty.size() != 0 || assigned_empty.size() != 0
+        || assigned_empty.is_item())
+    {
+        cout << " copies of it are not empty." << endl;
+        return 0;
+    }
+    copy_of_empty.insert(7);
+    source = moved;
+    if (!same_items(source, items, 4) || source.current() != 20
+        || copy_of_empty.size() != 1 || copy_of_empty.current() != 7)
+    {
+        cout << " assigning to it failed." << endl;
+        return 0;
+    }
+    sequence drained(std::move(source));
+    source.insert(40);
+    source.insert(30);
+    source.attach(35);
+    double refilled[3] = { 30, 35, 40 };
+    if (!same_items(source, refilled, 3) || source.current() != 35
+        || !same_items(drained, items, 4))
+    {
+        cout << " inserting into it failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Testing move assignment (and self-move) ...";
+    cout.flush();
+    sequence target;
+    target.attach(1);
+    array = moved.data();
+    target = std::move(moved);
+    if (!same_items(target, items, 4) || target.data() != array
+        || target.current() != 20 || moved.size() != 0 || moved.data() != 0)
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    sequence& alias = target;
+    target = std::move(alias);
+    if (!same_items(target, items, 4) || target.current() != 20)
+    {
+        cout << " self-move lost the items." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Testing member and nonmember swap ...";
+    cout.flush();
+    sequence pair;
+    pair.attach(5);
+    pair.attach(6);
+    pair.advance();
+    const double* target_array = target.data();
+    const double* pair_array = pair.data();
+    target.swap(pair);
+    if (!same_items(target, other_items, 2) || target.is_item()
+        || target.data() != pair_array
+        || !same_items(pair, items, 4) || pair.current() != 20
+        || pair.data() != target_array)
+    {
+        cout << " member swap failed." << endl;
+        return 0;
+    }
+    swap(target, pair);
+    if (!same_items(target, items, 4) || !same_items(pair, other_items, 2))
+    {
+        cout << " nonmember swap failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Testing reserve ...";
+    cout.flush();
+    sequence roomy(1);
+    roomy.attach(0);
+    roomy.reserve(100);
+    array = roomy.data();
+    for (i = 1; i < 100; i++)
+        roomy.attach(i);
+    roomy.reserve(10);
+    if (roomy.data() != array || roomy.size() != 100 || roomy.current() != 99)
+    {
+        cout << " the array was reallocated within the reserved capacity." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Testing shrink_to_fit ...";
+    cout.flush();
+    sequence loose(50);
+    for (i = 0; i < 4; i++)
+        loose.attach(items[i]);
+    loose.start();
+    loose.shrink_to_fit();
+    if (!same_items(loose, items, 4) || loose.current() != 10)
+    {
+        cout << " the items or the current item were lost." << endl;
+        return 0;
+    }
+    loose.attach(15);
+    double grown[5] = { 10, 15, 20, 30, 40 };
+    sequence emptied;
+    emptied.shrink_to_fit();
+    emptied.attach(1);
+    if (!same_items(loose, grown, 5) || loose.current() != 15
+        || emptied.size() != 1 || emptied.current() != 1)
+    {
+        cout << " the sequence did not grow again afterwards." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this ninth function have been passed." << endl;
+    return POINTS[9];
+}
+
+
+// **************************************************************************
+// int test10()
+//   Performs tests of sequence::cursor: several cursors walk one sequence
+//   independently while the sequence's own current item stays put.
+//   Returns POINTS[10] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test10()
+{
+    const size_t MANY = 50;
+    sequence test;
+    size_t i;
+
+    for (i = 0; i < MANY; i++)
+        test.attach(i);
+    test.move_to(17);
+
+    cout << "Walking three cursors over " << MANY << " items at different paces ...";
+    cout.flush();
+    sequence::cursor one(test), two(test), three(test);
+    size_t at_one = 0, at_two = 0, at_three = 0;
+    for (i = 0; i < MANY; i++)
+    {
+        if (!one.is_item() || one.current() != at_one)
+        {
+            cout << " the first cursor is at the wrong item." << endl;
+            return 0;
+        }
+        one.advance();
+        ++at_one;
+        if (i % 2 == 0 && two.is_item())
+        {
+            if (two.current() != at_two)
+            {
+                cout << " the second cursor is at the wrong item." << endl;
+                return 0;
+            }
+            two.advance();
+            ++at_two;
+        }
+        if (i % 10 == 9)
+        {
+            three.start();
+            at_three = 0;
+        }
+        else if (three.is_item())
+        {
+            three.advance();
+            ++at_three;
+        }
+        if (three.is_item() && three.current() != at_three)
+        {
+            cout << " the third cursor is at the wrong item." << endl;
+            return 0;
+        }
+    }
+    if (one.is_item() || !two.is_item() || two.current() != MANY / 2)
+    {
+        cout << " the cursors did not end where expected." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Checking the sequence's own current item did not move ...";
+    cout.flush();
+    if (!test.is_item() || test.current() != 17 || !counts_up(test))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    test.advance();
+    if (!three.is_item() || three.current() != at_three)
+    {
+        cout << " advancing the sequence moved a cursor." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Testing a cursor over an empty sequence ...";
+    cout.flush();
+    sequence empty;
+    sequence::cursor none(empty);
+    none.start();
+    if (none.is_item())
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this tenth function have been passed." << endl;
+    return POINTS[10];
+}
+
+int run_a_test(int number, const char message[], int test_function(), int max)
+{
+    int result;
+
+    cout << endl << "START OF TEST " << number << ":" << endl;
+    cout << message << " (" << max << " points)." << endl;
+    result = test_function();
+    if (result > 0)
+    {
+        cout << "Test " << number << " got " << result << " points";
+        cout << " out of a possible " << max << "." << endl;
+    }
+    else
+        cout << "Test " << number << " failed." << endl;
+    cout << "END OF TEST " << number << "." << endl << endl;
+
+    return result;
+}
+
+
+// **************************************************************************
+// int main()
+//   The main program calls all tests and prints the sum of all points
+//   earned from the tests.
+// **************************************************************************
+int main()
+{
+    int sum = 0;
+
+
+    cout << "Running " << DESCRIPTION[0] << endl;
+
+    sum += run_a_test(1, DESCRIPTION[1], test1, POINTS[1]);
+    sum += run_a_test(2, DESCRIPTION[2], test2, POINTS[2]);
+    sum += run_a_test(3, DESCRIPTION[3], test3, POINTS[3]);
+    sum += run_a_test(4, DESCRIPTION[4], test4, POINTS[4]);
+    sum += run_a_test(5, DESCRIPTION[5], test5, POINTS[5]);
+    sum += run_a_test(6, DESCRIPTION[6], test6, POINTS[6]);
+    sum += run_a_test(7, DESCRIPTION[7], test7, POINTS[7]);
+    sum += run_a_test(8, DESCRIPTION[8], test8, POINTS[8]);
+    sum += run_a_test(9, DESCRIPTION[9], test9, POINTS[9]);
+    sum += run_a_test(10, DESCRIPTION[10], test10, POINTS[10]);
+
+    cout << "The sequence extensions have scored\n";
+    cout << sum << " points out of the " << POINTS[0];
+    cout << " points based on this test program.\n";
+
+    return EXIT_SUCCESS;
+
+}
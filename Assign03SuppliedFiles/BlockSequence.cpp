@@ -0,0 +1,269 @@
+// FILE: BlockSequence.cpp
+// CLASS IMPLEMENTED: block_sequence (see BlockSequence.h for
+//                    documentation)
+// INVARIANT for the block_sequence class:
+//   1. The number of items in the sequence is in the member variable
+//      used.
+//   2. The items are stored, in order, in the blocks pointed to by the
+//      block directory blocks: first blocks[0]->items[0] through
+//      blocks[0]->items[blocks[0]->used - 1], then those of blocks[1],
+//      and so on. Every block in the directory holds at least one
+//      item, so an empty sequence has an empty directory.
+//   3. The current item is blocks[current_block]->items[current_offset].
+//      If there is no current item, current_block is blocks.size() and
+//      current_offset is 0 (this mirrors sequence's use of used as the
+//      "no current item" index).
+
+#include <cassert>
+#include <cstring>   // provides memcpy, memmove
+#include "BlockSequence.h"
+
+namespace CS3358_FA2021
+{
+   // CONSTRUCTORS and DESTRUCTOR
+   block_sequence::block_sequence(size_type initial_capacity) :
+      used(0),
+      current_block(0),
+      current_offset(0)
+   {
+      resize(initial_capacity);
+   }
+
+   block_sequence::block_sequence(const block_sequence& source) :
+      blocks(source.blocks.size()),
+      used(source.used),
+      current_block(source.current_block),
+      current_offset(source.current_offset)
+   {
+      // The directory starts out all null; if copying a block fails,
+      // free the blocks already copied (the destructor won't run)
+      try
+      {
+         for (size_type b = 0; b < blocks.size(); ++b)
+            blocks[b] = new block(*source.blocks[b]);
+      }
+      catch (...)
+      {
+         clear();
+         throw;
+      }
+   }
+
+   block_sequence::block_sequence(block_sequence&& source) noexcept :
+      used(source.used),
+      current_block(source.current_block),
+      current_offset(source.current_offset)
+   {
+      blocks.swap(source.blocks);
+      source.used = 0;
+      source.current_block = 0;
+      source.current_offset = 0;
+   }
+
+   block_sequence::~block_sequence() { clear(); }
+
+   // MODIFICATION MEMBER FUNCTIONS
+   void block_sequence::resize(size_type new_capacity)
+   {
+      blocks.reserve((new_capacity + BLOCK_CAPACITY - 1) / BLOCK_CAPACITY);
+   }
+
+   void block_sequence::start()
+   {
+      current_block = 0;
+      current_offset = 0;
+   }
+
+   void block_sequence::advance()
+   {
+      assert(is_item());
+      if (++current_offset == blocks[current_block]->used)
+      {
+         ++current_block;
+         current_offset = 0;
+      }
+   }
+
+   void block_sequence::insert(const value_type& entry)
+   {
+      // With no current item, insert at the front
+      if (!is_item())
+         start();
+      put(current_block, current_offset, entry);
+   }
+
+   void block_sequence::attach(const value_type& entry)
+   {
+      if (is_item())
+         put(current_block, current_offset + 1, entry);
+      else if (blocks.empty())
+         put(0, 0, entry);
+      else
+         put(blocks.size() - 1, blocks.back()->used, entry);
+   }
+
+   void block_sequence::remove_current()
+   {
+      assert(is_item());
+
+      block* here = blocks[current_block];
+      std::memmove(here->items + current_offset,
+                   here->items + current_offset + 1,
+                   (here->used - current_offset - 1) * sizeof(value_type));
+      --here->used;
+      --used;
+
+      if (here->used == 0)
+      {
+         // Drop the empty block; the next block's first item (if any)
+         // is now at (current_block, 0)
+         delete here;
+         blocks.erase(blocks.begin() + current_block);
+         current_offset = 0;
+         return;
+      }
+
+      // Merge an underfull block with its successor when both fit
+      if (here->used < BLOCK_CAPACITY / 4 && current_block + 1 < blocks.size())
+      {
+         block* next = blocks[current_block + 1];
+         if (here->used + next->used <= BLOCK_CAPACITY)
+         {
+            std::memcpy(here->items + here->used, next->items,
+                        next->used * sizeof(value_type));
+            here->used += next->used;
+            delete next;
+            blocks.erase(blocks.begin() + current_block + 1);
+         }
+      }
+
+      // If the removed item was last in its block, the new current item
+      // is the first item of the next block
+      if (current_offset == here->used)
+      {
+         ++current_block;
+         current_offset = 0;
+      }
+   }
+
+   block_sequence& block_sequence::operator=(const block_sequence& source)
+   {
+      if (this != &source)
+      {
+         block_sequence copy(source);
+         *this = std::move(copy);
+      }
+      return *this;
+   }
+
+   block_sequence& block_sequence::operator=(block_sequence&& source) noexcept
+   {
+      if (this != &source)
+      {
+         clear();
+         blocks.swap(source.blocks);
+         used = source.used;
+         current_block = source.current_block;
+         current_offset = source.current_offset;
+         source.used = 0;
+         source.current_block = 0;
+         source.current_offset = 0;
+      }
+      return *this;
+   }
+
+   // CONSTANT MEMBER FUNCTIONS
+   block_sequence::size_type block_sequence::size() const { return used; }
+
+   bool block_sequence::is_item() const
+   {
+      return (current_block < blocks.size());
+   }
+
+   block_sequence::value_type block_sequence::current() const
+   {
+      assert(is_item());
+      return blocks[current_block]->items[current_offset];
+   }
+
+   // HELPERS
+   // Puts entry at position offset of block b (offset may equal the
+   // block's used count; b and offset are ignored for an empty
+   // sequence) and makes it the current item. At most one block's
+   // items are moved.
+   void block_sequence::put(size_type b, size_type offset,
+                            const value_type& entry)
+   {
+      if (blocks.empty())
+      {
+         blocks.push_back(new_block());
+         b = offset = 0;
+      }
+      else if (blocks[b]->used == BLOCK_CAPACITY)
+      {
+         if (offset == BLOCK_CAPACITY)
+         {
+            // Just past a full block: use the front of the next block
+            // if it has room, else start a new block (appending in
+            // order therefore keeps the blocks full)
+            ++b;
+            offset = 0;
+            if (b == blocks.size() || blocks[b]->used == BLOCK_CAPACITY)
+               blocks.insert(blocks.begin() + b, new_block());
+         }
+         else if (offset == 0)
+         {
+            // Just before a full block: use the end of the previous
+            // block if it has room, else start a new block
+            if (b > 0 && blocks[b - 1]->used < BLOCK_CAPACITY)
+            {
+               --b;
+               offset = blocks[b]->used;
+            }
+            else
+               blocks.insert(blocks.begin() + b, new_block());
+         }
+         else
+         {
+            // Split the full block in halves; the entry goes in
+            // whichever half now holds its position
+            block* upper = new_block();
+            size_type half = BLOCK_CAPACITY / 2;
+            upper->used = BLOCK_CAPACITY - half;
+            std::memcpy(upper->items, blocks[b]->items + half,
+                        upper->used * sizeof(value_type));
+            blocks[b]->used = half;
+            blocks.insert(blocks.begin() + b + 1, upper);
+            if (offset > half)
+            {
+               ++b;
+               offset -= half;
+            }
+         }
+      }
+
+      block* here = blocks[b];
+      std::memmove(here->items + offset + 1, here->items + offset,
+                   (here->used - offset) * sizeof(value_type));
+      here->items[offset] = entry;
+      ++here->used;
+      ++used;
+
+      current_block = b;
+      current_offset = offset;
+   }
+
+   block_sequence::block* block_sequence::new_block()
+   {
+      block* fresh = new block;
+      fresh->used = 0;
+      return fresh;
+   }
+
+   void block_sequence::clear()
+   {
+      for (size_type b = 0; b < blocks.size(); ++b)
+         delete blocks[b];
+      blocks.clear();
+   }
+}
@@ -0,0 +1,113 @@
+// FILE: BlockSequence.h
+// CLASS PROVIDED: block_sequence (part of the namespace CS3358_FA2021)
+//
+// A block_sequence stores its items in a series of fixed size blocks
+// (an "unrolled" list) instead of one flat array. Inserting or removing
+// at the cursor therefore moves at most one block's worth of items,
+// instead of shifting the whole tail of the sequence, while stepping
+// the cursor through a block stays cache friendly.
+//
+// It implements the original cursor interface of sequence (see
+// Sequence.h): the constructor, resize, start, advance, insert,
+// attach, remove_current, size, is_item, current, copying, moving and
+// assignment, each behaving as documented for sequence. Code limited
+// to these can switch between the two classes by choosing which one
+// to construct. The rest of sequence's interface (iterators and
+// data(), move_to, the range functions, reserve, shrink_to_fit, swap,
+// the reduction and persistence functions, and cursor) is not
+// provided, since it depends on the items being one flat array or
+// has no block-wise version yet.
+//
+// TYPEDEFS and MEMBER CONSTANTS for the block_sequence class:
+//   typedef ____ value_type
+//   typedef ____ size_type
+//   static const size_type DEFAULT_CAPACITY = _____
+//    As for sequence.
+//
+//   static const size_type BLOCK_CAPACITY = _____
+//    block_sequence::BLOCK_CAPACITY is the number of items each block
+//    can hold.
+//
+// CONSTRUCTOR for the block_sequence class:
+//   block_sequence(size_type initial_capacity = DEFAULT_CAPACITY)
+//    Pre:  none
+//    Post: The block_sequence has been initialized as an empty sequence,
+//      with room in its block directory for initial_capacity items.
+//
+// MODIFICATION MEMBER FUNCTIONS for the block_sequence class:
+//   void resize(size_type new_capacity)
+//    Post: The block directory has room for new_capacity items (blocks
+//      themselves are allocated as they fill, so nothing is copied).
+//
+//   void start()
+//   void advance()
+//   void insert(const value_type& entry)
+//   void attach(const value_type& entry)
+//   void remove_current()
+//    As for sequence. insert and attach split a full block in two;
+//    remove_current frees a block that becomes empty and merges a block
+//    that falls below a quarter full with its successor when they fit
+//    in one block.
+//
+// CONSTANT MEMBER FUNCTIONS for the block_sequence class:
+//   size_type size() const
+//   bool is_item() const
+//   value_type current() const
+//    As for sequence.
+//
+// VALUE SEMANTICS for the block_sequence class:
+//   Assignments and the copy constructor may be used with
+//   block_sequence objects; moves transfer the blocks without copying.
+
+#ifndef BLOCK_SEQUENCE_H
+#define BLOCK_SEQUENCE_H
+#include <cstdlib>  // provides size_t
+#include <vector>   // provides std::vector
+
+namespace CS3358_FA2021
+{
+   class block_sequence
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef double value_type;
+      typedef std::size_t size_type;
+      static const size_type DEFAULT_CAPACITY = 30;
+      static const size_type BLOCK_CAPACITY = 256;
+      // CONSTRUCTORS and DESTRUCTOR
+      block_sequence(size_type initial_capacity = DEFAULT_CAPACITY);
+      block_sequence(const block_sequence& source);
+      block_sequence(block_sequence&& source) noexcept;
+      ~block_sequence();
+      // MODIFICATION MEMBER FUNCTIONS
+      void resize(size_type new_capacity);
+      void start();
+      void advance();
+      void insert(const value_type& entry);
+      void attach(const value_type& entry);
+      void remove_current();
+      block_sequence& operator=(const block_sequence& source);
+      block_sequence& operator=(block_sequence&& source) noexcept;
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      bool is_item() const;
+      value_type current() const;
+   private:
+      struct block
+      {
+         value_type items[BLOCK_CAPACITY];
+         size_type used;
+      };
+
+      std::vector<block*> blocks;
+      size_type used;
+      size_type current_block;
+      size_type current_offset;
+      // HELPERS
+      void put(size_type b, size_type offset, const value_type& entry);
+      void clear();
+      static block* new_block();
+   };
+}
+
+#endif
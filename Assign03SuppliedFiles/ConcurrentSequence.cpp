@@ -0,0 +1,131 @@
+// FILE: ConcurrentSequence.cpp
+// CLASS IMPLEMENTED: concurrent_sequence (see ConcurrentSequence.h for
+//                    documentation)
+// INVARIANT for the concurrent_sequence class:
+//   1. The writer's working sequence is in the member variable draft;
+//      only the writer thread touches it.
+//   2. The most recently published version is held by a heap-allocated
+//      snapshot pointed to by the atomic member variable published. The
+//      version is never modified after it has been published, and the
+//      snapshot object holding it is never modified either, so any
+//      number of readers may copy it at once.
+//   3. A reader that is copying a snapshot object has its address in
+//      one of the hazard slots (hazards[k]), and stored it there before
+//      checking that the object is still the published one. Unused
+//      slots are null.
+//   4. The snapshot objects replaced by publish() are in the member
+//      variable replaced until no hazard slot holds them; then they are
+//      deleted (which releases the writer's reference to the version).
+//   5. The last version released that way is kept (writable) in the
+//      member variable retired. Readers may still hold snapshots of it;
+//      once none do (use_count() == 1), its buffer is reused for the
+//      next publish instead of allocating a fresh one.
+
+#include <algorithm>  // provides std::find
+#include "ConcurrentSequence.h"
+
+namespace CS3358_FA2021
+{
+   const concurrent_sequence::size_type concurrent_sequence::READER_SLOTS;
+
+   concurrent_sequence::concurrent_sequence(size_type initial_capacity) :
+      draft(initial_capacity),
+      published(new snapshot(std::make_shared<sequence>()))
+   {
+      for (size_type k = 0; k < READER_SLOTS; ++k)
+         hazards[k].store(0);
+   }
+
+   concurrent_sequence::~concurrent_sequence()
+   {
+      // No reader may still be inside read() at this point
+      delete published.load();
+      for (size_type i = 0; i < replaced.size(); ++i)
+         delete replaced[i];
+   }
+
+   concurrent_sequence::snapshot concurrent_sequence::read() const
+   {
+      // Claim a free hazard slot, announcing the version we are about
+      // to copy
+      const snapshot* current = published.load();
+      const snapshot* expected = 0;
+      size_type k = 0;
+      while (!hazards[k].compare_exchange_strong(expected, current))
+      {
+         expected = 0;
+         k = (k + 1) % READER_SLOTS;
+      }
+
+      // The writer may have replaced (and, before seeing our slot,
+      // freed) that version meanwhile: re-announce until the version
+      // announced is still the published one. From then on the writer
+      // will not free it until we clear the slot.
+      for (;;)
+      {
+         const snapshot* again = published.load();
+         if (again == current)
+            break;
+         current = again;
+         hazards[k].store(current);
+      }
+
+      snapshot result = *current;
+      hazards[k].store(0);
+      return result;
+   }
+
+   sequence& concurrent_sequence::working() { return draft; }
+
+   void concurrent_sequence::publish()
+   {
+      // Build the new version in the retired buffer if no reader still
+      // holds it, or in a fresh one otherwise
+      std::shared_ptr<sequence> next;
+      if (retired && retired.use_count() == 1)
+      {
+         // Pairs with the release in the last reader's count decrement,
+         // so its reads of the buffer happen before we overwrite it
+         std::atomic_thread_fence(std::memory_order_acquire);
+         next.swap(retired);
+         *next = draft;
+      }
+      else
+         next = std::make_shared<sequence>(draft);
+
+      // Swap it in; readers pick it up on their next read()
+      const snapshot* fresh = new snapshot(next);
+      replaced.push_back(published.exchange(fresh));
+      reclaim();
+   }
+
+   void concurrent_sequence::reclaim()
+   {
+      // Every hazard slot is read after the exchange in publish(), so a
+      // reader that announces a replaced version later than this scan
+      // also sees it is no longer published and moves on
+      std::vector<const snapshot*> in_use;
+      for (size_type k = 0; k < READER_SLOTS; ++k)
+      {
+         const snapshot* h = hazards[k].load();
+         if (h != 0)
+            in_use.push_back(h);
+      }
+
+      size_type kept = 0;
+      for (size_type i = 0; i < replaced.size(); ++i)
+      {
+         if (std::find(in_use.begin(), in_use.end(), replaced[i])
+             != in_use.end())
+            replaced[kept++] = replaced[i];
+         else
+         {
+            // Every version is created in publish() (or in the
+            // constructor) as a non-const sequence, so it may be reused
+            retired = std::const_pointer_cast<sequence>(*replaced[i]);
+            delete replaced[i];
+         }
+      }
+      replaced.resize(kept);
+   }
+}
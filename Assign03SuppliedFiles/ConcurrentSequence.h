@@ -0,0 +1,112 @@
+// FILE: ConcurrentSequence.h
+// CLASS PROVIDED: concurrent_sequence (part of the namespace CS3358_FA2021)
+//
+// A concurrent_sequence lets one writer thread edit a sequence while
+// any number of reader threads scan it, without the readers ever
+// waiting for the writer's edits. The writer edits a private working
+// sequence and, when a batch of edits is complete, publishes it. Each
+// reader takes a snapshot: an immutable version of the sequence as of
+// some publish. A snapshot stays valid and unchanged for as long as
+// the reader holds it, however many versions are published meanwhile.
+// An old version is freed as soon as the last snapshot of it is
+// released.
+//
+// Readers never lock: read() loads the published version through an
+// atomic pointer, announces it in one of READER_SLOTS hazard slots so
+// the writer will not free it, and takes a snapshot (a shared_ptr
+// copy, whose count is updated with atomic instructions). The writer
+// frees a replaced version only once no slot announces it.
+//
+// TYPEDEFS and MEMBER CONSTANTS for the concurrent_sequence class:
+//   typedef ____ snapshot
+//    concurrent_sequence::snapshot is a shared, read-only handle to one
+//    published version of the sequence. Dereferencing it gives a
+//    const sequence&, which may be traversed with its const iterators,
+//    its reduction functions, or sequence::cursor objects (a snapshot's
+//    own current item cannot be moved, since the version is shared).
+//
+//   static const size_type READER_SLOTS = _____
+//    concurrent_sequence::READER_SLOTS is the number of hazard slots,
+//    i.e. the number of read() calls that can be in progress at the
+//    same instant. A read() that finds every slot in use retries until
+//    one is given back (each slot is held only while one pointer is
+//    copied, not for as long as the snapshot is kept).
+//
+// CONSTRUCTOR for the concurrent_sequence class:
+//   concurrent_sequence(size_type initial_capacity = DEFAULT_CAPACITY)
+//    Pre:  none
+//    Post: The working sequence and the published version are both
+//      empty; initial_capacity is passed on to the working sequence.
+//
+// READER MEMBER FUNCTIONS for the concurrent_sequence class:
+//   snapshot read() const
+//    Pre:  none
+//    Post: The return value is the most recently published version.
+//    Note: May be called from any number of threads at once. It takes
+//      no lock; it retries if a publish() replaces the version it is
+//      taking.
+//
+// WRITER MEMBER FUNCTIONS for the concurrent_sequence class:
+//   (Only one thread at a time may use these.)
+//   sequence& working()
+//    Pre:  none
+//    Post: The return value refers to the writer's working sequence,
+//      which may be edited freely (insert, attach, remove_current,
+//      range functions, ...). Readers do not see the edits until the
+//      next publish().
+//
+//   void publish()
+//    Pre:  none
+//    Post: A copy of the working sequence has become the published
+//      version returned by later calls to read(). Readers holding
+//      earlier snapshots are unaffected.
+//    Note: Publishing copies the working sequence once (O(n)), so the
+//      writer should publish after a batch of edits rather than after
+//      each one. The buffer of a retired version that no reader holds
+//      any more is reused for the next publish. Replaced versions that
+//      a reader is still taking are kept until a later publish() (or
+//      the destructor) finds them released.
+//
+// VALUE SEMANTICS for the concurrent_sequence class:
+//   concurrent_sequence objects may not be copied or assigned.
+
+#ifndef CONCURRENT_SEQUENCE_H
+#define CONCURRENT_SEQUENCE_H
+#include <atomic>     // provides std::atomic
+#include <memory>     // provides std::shared_ptr
+#include <vector>     // provides std::vector
+#include "Sequence.h"
+
+namespace CS3358_FA2021
+{
+   class concurrent_sequence
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef sequence::size_type size_type;
+      typedef std::shared_ptr<const sequence> snapshot;
+      static const size_type READER_SLOTS = 64;
+      // CONSTRUCTOR and DESTRUCTOR
+      concurrent_sequence(size_type initial_capacity =
+                             sequence::DEFAULT_CAPACITY);
+      ~concurrent_sequence();
+      // READER MEMBER FUNCTIONS
+      snapshot read() const;
+      // WRITER MEMBER FUNCTIONS
+      sequence& working();
+      void publish();
+   private:
+      concurrent_sequence(const concurrent_sequence&);
+      concurrent_sequence& operator=(const concurrent_sequence&);
+
+      void reclaim();
+
+      sequence draft;
+      std::atomic<const snapshot*> published;
+      mutable std::atomic<const snapshot*> hazards[READER_SLOTS];
+      std::vector<const snapshot*> replaced;
+      std::shared_ptr<sequence> retired;
+   };
+}
+
+#endif
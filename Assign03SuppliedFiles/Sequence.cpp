@@ -7,13 +7,19 @@
 //      used;
 //   2. The actual items of the sequence are stored in a partially
 //      filled array. The array is a dynamic array, pointed to by
-//      the member variable data. For an empty sequence, we do not
-//      care what is stored in any of data; for a non-empty sequence
-//      the items in the sequence are stored in data[0] through
-//      data[used-1], and we don't care what's in the rest of data.
+//      the member variable items. For an empty sequence, we do not
+//      care what is stored in any of items; for a non-empty sequence
+//      the items in the sequence are stored in items[0] through
+//      items[used-1], and we don't care what's in the rest of items.
 //   3. The size of the dynamic array is in the member variable
-//      capacity.
-//   4. The index of the current item is in the member variable
+//      capacity. If the array lives in a memory mapping (see
+//      LARGE_ARRAY_BYTES), the number of items the mapping can hold
+//      is in the member variable reserved (reserved >= capacity);
+//      otherwise reserved is 0.
+//   4. If the array is a private mapping of a file written by save,
+//      from_file is true, the mapping starts FILE_HEADER_BYTES before
+//      items and reserved holds the number of items in the file.
+//   5. The index of the current item is in the member variable
 //      current_index. If there is no valid current item, then
 //      current_index will be set to the same number as used.
 //      NOTE: Setting current_index to be the same as used to
@@ -43,37 +49,572 @@
 #include <cassert>
 #include "Sequence.h"
 #include <iostream>
+#include <utility>      // provides std::swap
+#include <algorithm>    // provides std::copy, std::copy_backward
+#include <cstring>      // provides memcpy, memmove
+#include <new>          // provides std::bad_alloc
+#include <type_traits>  // provides std::is_trivially_copyable
+#include <functional>   // provides std::ref
+#include <thread>       // provides std::thread
+#include <vector>       // provides std::vector
+#include <cstdio>       // provides FILE, fopen, fwrite, fread, rename
+#include <string>       // provides std::string
+#include <stdint.h>     // provides uint32_t, uint64_t
+#if defined(__linux__)
+#include <sys/mman.h>   // provides mmap, mremap, munmap, madvise
+#include <sys/stat.h>   // provides fstat
+#include <fcntl.h>      // provides open
+#include <unistd.h>     // provides close, sysconf
+#define SEQUENCE_MAP_LARGE_ARRAYS
+#endif
+#if defined(__AVX__)
+#include <immintrin.h>  // provides __m256d and the AVX intrinsics
+#define SEQUENCE_SIMD_LANES
+#elif defined(__SSE2__)
+#include <emmintrin.h>  // provides __m128d and the SSE2 intrinsics
+#define SEQUENCE_SIMD_LANES
+#endif
 using namespace std;
 
+namespace
+{
+   // Storage helpers for the item array. Trivially copyable items
+   // (such as double) are kept in malloc'd memory so that growth can
+   // use realloc (which can extend in place, or remap large blocks
+   // instead of copying them) and shifting can use memmove; any other
+   // value_type falls back to new[]/delete[] and item-by-item copies.
+   // The std::true_type/std::false_type argument selects the version.
+   //
+   // Trivially copyable arrays of LARGE_ARRAY_BYTES or more are kept
+   // in their own anonymous mapping instead. reserved is the number of
+   // items the mapping can hold (0 for a heap array); it is set and
+   // cleared by these helpers.
+   typedef CS3358_FA2021::sequence::value_type value_type;
+   typedef CS3358_FA2021::sequence::size_type size_type;
+   typedef is_trivially_copyable<value_type> trivial_items;
+
+   inline bool is_large(size_type n)
+   {
+      return n * sizeof(value_type) >=
+             CS3358_FA2021::sequence::LARGE_ARRAY_BYTES;
+   }
+
+#ifdef SEQUENCE_MAP_LARGE_ARRAYS
+   const size_type HUGE_PAGE_BYTES = 2 * 1024 * 1024;
+   const size_type MAP_HEADROOM = 4;  // reserve this many times the request
+
+   inline size_type mapping_bytes(size_type n)
+   {
+      size_type bytes = n * sizeof(value_type) * MAP_HEADROOM;
+      return (bytes + HUGE_PAGE_BYTES - 1) / HUGE_PAGE_BYTES * HUGE_PAGE_BYTES;
+   }
+
+   // Reserve address space for at least n items, aligned to a huge page.
+   // MAP_NORESERVE leaves the pages uncommitted until first written.
+   value_type* map_items(size_type n, size_type& reserved)
+   {
+      size_type bytes = mapping_bytes(n),
+                span = bytes + HUGE_PAGE_BYTES;
+      void* p = mmap(0, span, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+      if (p == MAP_FAILED)
+         throw bad_alloc();
+
+      // Trim the unaligned head and the unused tail of the span
+      char* base = static_cast<char*>(p);
+      size_type skew = reinterpret_cast<size_t>(base) % HUGE_PAGE_BYTES;
+      size_type head = (skew == 0) ? 0 : HUGE_PAGE_BYTES - skew;
+      if (head > 0)
+         munmap(base, head);
+      munmap(base + head + bytes, span - head - bytes);
+
+      madvise(base + head, bytes, MADV_HUGEPAGE);
+      reserved = bytes / sizeof(value_type);
+      return reinterpret_cast<value_type*>(base + head);
+   }
+
+   // Grow a mapping past its reservation; the kernel moves the page
+   // tables, not the items.
+   value_type* remap_items(value_type* p, size_type n, size_type& reserved)
+   {
+      size_type bytes = mapping_bytes(n);
+      void* q = mremap(p, reserved * sizeof(value_type), bytes,
+                       MREMAP_MAYMOVE);
+      if (q == MAP_FAILED)
+         throw bad_alloc();
+
+      madvise(q, bytes, MADV_HUGEPAGE);
+      reserved = bytes / sizeof(value_type);
+      return static_cast<value_type*>(q);
+   }
+
+   // Give back the committed pages past the first n items of a mapping;
+   // the address space stays reserved, and the pages read as zero (and
+   // are committed again) if touched later
+   inline void release_tail(value_type* p, size_type n, size_type reserved)
+   {
+      size_type page = sysconf(_SC_PAGESIZE),
+                keep = (n * sizeof(value_type) + page - 1) / page * page,
+                bytes = reserved * sizeof(value_type);
+      if (keep < bytes)
+         madvise(reinterpret_cast<char*>(p) + keep, bytes - keep,
+                 MADV_DONTNEED);
+   }
+
+   inline void unmap_items(value_type* p, size_type& reserved)
+   {
+      munmap(p, reserved * sizeof(value_type));
+      reserved = 0;
+   }
+#endif
+
+   inline value_type* heap_items(size_type n)
+   {
+      void* p = malloc(n * sizeof(value_type));
+      if (p == 0)
+         throw bad_alloc();
+      return static_cast<value_type*>(p);
+   }
+
+   inline value_type* allocate_items(size_type n, size_type& reserved,
+                                     true_type)
+   {
+      reserved = 0;
+      if (n == 0)
+         return 0;
+#ifdef SEQUENCE_MAP_LARGE_ARRAYS
+      if (is_large(n))
+         return map_items(n, reserved);
+#endif
+      return heap_items(n);
+   }
+
+   inline value_type* allocate_items(size_type n, size_type& reserved,
+                                     false_type)
+   {
+      reserved = 0;
+      return (n == 0) ? 0 : new value_type[n];
+   }
+
+   inline void free_items(value_type* p, size_type& reserved, true_type)
+   {
+#ifdef SEQUENCE_MAP_LARGE_ARRAYS
+      if (reserved > 0)
+      {
+         unmap_items(p, reserved);
+         return;
+      }
+#endif
+      free(p);
+   }
+
+   inline void free_items(value_type* p, size_type& /* reserved */,
+                          false_type)
+   { delete [] p; }
+
+   value_type* regrow_items(value_type* p, size_type used, size_type n,
+                            size_type& reserved, true_type)
+   {
+#ifdef SEQUENCE_MAP_LARGE_ARRAYS
+      if (reserved > 0)
+      {
+         if (!is_large(n))
+         {
+            // Shrunk below the threshold: back to the heap
+            value_type* q = heap_items(n);
+            memcpy(q, p, used * sizeof(value_type));
+            unmap_items(p, reserved);
+            return q;
+         }
+         if (n <= reserved)
+         {
+            // Already reserved (pages commit on first touch); anything
+            // committed past the new capacity is returned, so shrinking
+            // gives memory back
+            release_tail(p, n, reserved);
+            return p;
+         }
+         return remap_items(p, n, reserved);
+      }
+      if (is_large(n))
+      {
+         value_type* q = map_items(n, reserved);
+         memcpy(q, p, used * sizeof(value_type));
+         free(p);
+         return q;
+      }
+#else
+      (void) used;
+      (void) reserved;
+#endif
+      void* q = realloc(p, n * sizeof(value_type));
+      if (q == 0)
+         throw bad_alloc();
+      return static_cast<value_type*>(q);
+   }
+
+   inline value_type* regrow_items(value_type* p, size_type used,
+                                   size_type n, size_type& /* reserved */,
+                                   false_type)
+   {
+      value_type* q = new value_type[n];
+      copy(p, p + used, q);
+      delete [] p;
+      return q;
+   }
+
+   // Reduction kernels. pairwise_sum adds term(i) for i in [first, last)
+   // by splitting the range in halves down to blocks of PAIRWISE_BLOCK,
+   // each summed into four independent lanes (lane k takes the terms
+   // i + k). Where SSE2 or AVX is available the four lanes are held in
+   // vector registers and each Term also provides four(i), the terms
+   // i .. i+3 as one vector; the additions are done lane by lane in the
+   // same order either way, so both versions give identical results.
+   // (The vector versions assume value_type is double.)
+   const size_type PAIRWISE_BLOCK = 256;
+
+#if defined(__AVX__)
+   struct quad
+   {
+      __m256d v;
+      static quad zero() { quad q = { _mm256_setzero_pd() }; return q; }
+      static quad load(const value_type* p)
+      { quad q = { _mm256_loadu_pd(p) }; return q; }
+      static quad fill(value_type x) { quad q = { _mm256_set1_pd(x) }; return q; }
+      quad operator+(const quad& b) const
+      { quad q = { _mm256_add_pd(v, b.v) }; return q; }
+      quad operator-(const quad& b) const
+      { quad q = { _mm256_sub_pd(v, b.v) }; return q; }
+      quad operator*(const quad& b) const
+      { quad q = { _mm256_mul_pd(v, b.v) }; return q; }
+      void store(value_type* p) const { _mm256_storeu_pd(p, v); }
+   };
+#elif defined(__SSE2__)
+   struct quad
+   {
+      __m128d lo;  // lanes 0 and 1
+      __m128d hi;  // lanes 2 and 3
+      static quad zero()
+      { quad q = { _mm_setzero_pd(), _mm_setzero_pd() }; return q; }
+      static quad load(const value_type* p)
+      { quad q = { _mm_loadu_pd(p), _mm_loadu_pd(p + 2) }; return q; }
+      static quad fill(value_type x)
+      { quad q = { _mm_set1_pd(x), _mm_set1_pd(x) }; return q; }
+      quad operator+(const quad& b) const
+      { quad q = { _mm_add_pd(lo, b.lo), _mm_add_pd(hi, b.hi) }; return q; }
+      quad operator-(const quad& b) const
+      { quad q = { _mm_sub_pd(lo, b.lo), _mm_sub_pd(hi, b.hi) }; return q; }
+      quad operator*(const quad& b) const
+      { quad q = { _mm_mul_pd(lo, b.lo), _mm_mul_pd(hi, b.hi) }; return q; }
+      void store(value_type* p) const
+      {
+         _mm_storeu_pd(p, lo);
+         _mm_storeu_pd(p + 2, hi);
+      }
+   };
+#endif
+
+   struct item_term
+   {
+      const value_type* p;
+      value_type operator()(size_type i) const { return p[i]; }
+#ifdef SEQUENCE_SIMD_LANES
+      quad four(size_type i) const { return quad::load(p + i); }
+#endif
+   };
+
+   struct product_term
+   {
+      const value_type* p;
+      const value_type* q;
+      value_type operator()(size_type i) const { return p[i] * q[i]; }
+#ifdef SEQUENCE_SIMD_LANES
+      quad four(size_type i) const
+      { return quad::load(p + i) * quad::load(q + i); }
+#endif
+   };
+
+   struct squared_deviation_term
+   {
+      const value_type* p;
+      value_type center;
+      value_type operator()(size_type i) const
+      {
+         value_type d = p[i] - center;
+         return d * d;
+      }
+#ifdef SEQUENCE_SIMD_LANES
+      quad four(size_type i) const
+      {
+         quad d = quad::load(p + i) - quad::fill(center);
+         return d * d;
+      }
+#endif
+   };
+
+   template <class Term>
+   value_type pairwise_sum(const Term& term, size_type first, size_type last)
+   {
+      if (last - first > PAIRWISE_BLOCK)
+      {
+         size_type mid = first + (last - first) / 2;
+         return pairwise_sum(term, first, mid) + pairwise_sum(term, mid, last);
+      }
+
+      value_type lane[4] = { 0, 0, 0, 0 };
+      size_type i = first;
+#ifdef SEQUENCE_SIMD_LANES
+      quad lanes = quad::zero();
+      for (; i + 4 <= last; i += 4)
+         lanes = lanes + term.four(i);
+      lanes.store(lane);
+#else
+      for (; i + 4 <= last; i += 4)
+      {
+         lane[0] += term(i);
+         lane[1] += term(i + 1);
+         lane[2] += term(i + 2);
+         lane[3] += term(i + 3);
+      }
+#endif
+      for (; i < last; ++i)
+         lane[0] += term(i);
+      return (lane[0] + lane[1]) + (lane[2] + lane[3]);
+   }
+
+   // Largest (Largest true) or smallest item of p[first..last-1],
+   // tracked in four independent lanes
+   template <bool Largest>
+   inline value_type better(value_type a, value_type b)
+   { return (Largest ? a > b : a < b) ? a : b; }
+
+   template <bool Largest>
+   value_type extreme(const value_type* p, size_type first, size_type last)
+   {
+      value_type lane[4] = { p[first], p[first], p[first], p[first] };
+      size_type i = first;
+      for (; i + 4 <= last; i += 4)
+         for (size_type k = 0; k < 4; ++k)
+            lane[k] = better<Largest>(p[i + k], lane[k]);
+      for (; i < last; ++i)
+         lane[0] = better<Largest>(p[i], lane[0]);
+      return better<Largest>(better<Largest>(lane[0], lane[1]),
+                             better<Largest>(lane[2], lane[3]));
+   }
+
+   // Splits [0, n) into one chunk per hardware thread (a single chunk
+   // below PARALLEL_CUTOFF) and calls work(first, last, parts[k]) for
+   // each chunk k, the first on the calling thread.
+   template <class Part, class Work>
+   void split_work(size_type n, vector<Part>& parts, Work work)
+   {
+      size_type chunks = 1;
+      if (n >= CS3358_FA2021::sequence::PARALLEL_CUTOFF)
+      {
+         size_type cores = thread::hardware_concurrency();
+         chunks = (cores > 1) ? cores : 1;
+      }
+
+      parts.resize(chunks);
+      vector<thread> workers;
+      workers.reserve(chunks - 1);
+      try
+      {
+         for (size_type k = 1; k < chunks; ++k)
+            workers.push_back(thread(work, k * n / chunks,
+                                     (k + 1) * n / chunks,
+                                     std::ref(parts[k])));
+         work(0, n / chunks, parts[0]);
+      }
+      catch (...)
+      {
+         // A thread could not be started: the ones already running must
+         // be joined before they are destroyed (or std::terminate runs)
+         for (size_type k = 0; k < workers.size(); ++k)
+            workers[k].join();
+         throw;
+      }
+      for (size_type k = 0; k < workers.size(); ++k)
+         workers[k].join();
+   }
+
+   struct sum_work
+   {
+      item_term term;
+      void operator()(size_type first, size_type last, value_type& out) const
+      { out = pairwise_sum(term, first, last); }
+   };
+
+   struct dot_work
+   {
+      product_term term;
+      void operator()(size_type first, size_type last, value_type& out) const
+      { out = pairwise_sum(term, first, last); }
+   };
+
+   template <bool Largest>
+   struct extreme_work
+   {
+      const value_type* p;
+      void operator()(size_type first, size_type last, value_type& out) const
+      { out = extreme<Largest>(p, first, last); }
+   };
+
+   // Count, mean and sum of squared deviations of one chunk
+   struct moments
+   {
+      size_type n;
+      value_type mean;
+      value_type m2;
+   };
+
+   struct moments_work
+   {
+      const value_type* p;
+      void operator()(size_type first, size_type last, moments& out) const
+      {
+         item_term items = { p };
+         out.n = last - first;
+         out.mean = pairwise_sum(items, first, last) / out.n;
+         squared_deviation_term deviations = { p, out.mean };
+         out.m2 = pairwise_sum(deviations, first, last);
+      }
+   };
+
+   // Persistence helpers. The file header is padded to FILE_HEADER_BYTES
+   // so that the items that follow it stay aligned.
+   const char FILE_MAGIC[8] = { 'C', 'S', '3', '3', '5', '8', 'S', 'Q' };
+   const uint32_t FILE_VERSION = 1;
+   const size_type FILE_HEADER_BYTES = 64;
+
+   struct file_header
+   {
+      char magic[8];
+      uint32_t version;
+      uint32_t item_bytes;
+      uint64_t count;
+      uint64_t current_index;
+      uint64_t checksum;
+      char padding[FILE_HEADER_BYTES - 40];
+   };
+
+   // 64-bit checksum of the payload, folding 8 bytes at a time into
+   // four independent lanes so it runs close to memory speed
+   uint64_t payload_checksum(const void* payload, size_type bytes)
+   {
+      const unsigned char* p = static_cast<const unsigned char*>(payload);
+      const uint64_t PRIME = 0x100000001B3ULL;
+      uint64_t lane[4] = { 0x9E3779B97F4A7C15ULL, 0xC2B2AE3D27D4EB4FULL,
+                           0x165667B19E3779F9ULL, 0x27D4EB2F165667C5ULL };
+      size_type i = 0;
+      for (; i + 32 <= bytes; i += 32)
+         for (size_type k = 0; k < 4; ++k)
+         {
+            uint64_t word;
+            memcpy(&word, p + i + 8 * k, 8);
+            lane[k] = (lane[k] ^ word) * PRIME;
+         }
+      for (; i < bytes; ++i)
+         lane[0] = (lane[0] ^ p[i]) * PRIME;
+
+      uint64_t sum = bytes;
+      for (size_type k = 0; k < 4; ++k)
+         sum = (sum ^ lane[k]) * PRIME;
+      return sum;
+   }
+
+   inline bool valid_header(const file_header& header, size_type file_bytes)
+   {
+      // The count is checked against the payload size by division first,
+      // so a huge count cannot wrap the multiplication around to a
+      // matching size
+      return memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) == 0 &&
+             header.version == FILE_VERSION &&
+             header.item_bytes == sizeof(value_type) &&
+             file_bytes >= FILE_HEADER_BYTES &&
+             header.count <= (file_bytes - FILE_HEADER_BYTES) /
+                             sizeof(value_type) &&
+             file_bytes == FILE_HEADER_BYTES +
+                           header.count * sizeof(value_type);
+   }
+
+   inline void copy_items(value_type* dst, const value_type* src, size_type n,
+                          true_type)
+   {
+      if (n > 0)
+         memcpy(dst, src, n * sizeof(value_type));
+   }
+
+   inline void copy_items(value_type* dst, const value_type* src, size_type n,
+                          false_type)
+   { copy(src, src + n, dst); }
+
+   // Like copy_items, but the two ranges may overlap
+   inline void move_items(value_type* dst, value_type* src, size_type n,
+                          true_type)
+   {
+      if (n > 0)
+         memmove(dst, src, n * sizeof(value_type));
+   }
+
+   inline void move_items(value_type* dst, value_type* src, size_type n,
+                          false_type)
+   {
+      if (dst < src)
+         copy(src, src + n, dst);
+      else
+         copy_backward(src, src + n, dst + n);
+   }
+}
+
 namespace CS3358_FA2021
 {
    // CONSTRUCTORS and DESTRUCTOR
    sequence::sequence(size_type initial_capacity) : 
       used(0),  
       current_index(0),
-      capacity(initial_capacity)
+      capacity(initial_capacity),
+      from_file(false)
    {
       // Check that initial capacity is valid
       if (initial_capacity < 1)
          capacity = 1;
 
-      data = new value_type[capacity];
+      items = allocate_items(capacity, reserved, trivial_items());
    }
 
    sequence::sequence(const sequence& source) : 
       used(source.used),
       current_index(source.current_index),
-      capacity(source.capacity)
+      capacity(source.capacity),
+      from_file(false)
    {
       // Copy data to a new array in memory
-      data = new value_type[capacity];
-      for (size_type i = 0; i < used; i++)
-         data[i] = source.data[i];
+      items = allocate_items(capacity, reserved, trivial_items());
+      copy_items(items, source.items, used, trivial_items());
+   }
+
+   sequence::sequence(sequence&& source) noexcept :
+      items(source.items),
+      used(source.used),
+      current_index(source.current_index),
+      capacity(source.capacity),
+      reserved(source.reserved),
+      from_file(source.from_file)
+   {
+      // Leave source empty and without an array so its
+      // destructor has nothing to free
+      source.items = 0;
+      source.used = 0;
+      source.current_index = 0;
+      source.capacity = 0;
+      source.reserved = 0;
+      source.from_file = false;
    }
 
    sequence::~sequence()
    {
-      delete [] data;
+      release_items();
    }
 
    // MODIFICATION MEMBER FUNCTIONS
@@ -87,18 +628,47 @@ namespace CS3358_FA2021
       if (new_capacity < 1)
          new_capacity = 1;
 
-      // If the above is satisfied set capacity
-      // then create a new array with the new capacity
-      // and transfer data
+      // If the above is satisfied regrow the array to the
+      // new capacity, transferring data (in place if the
+      // allocator can manage it), then set capacity.
+      // A loaded file can't be regrown in place; copy it out.
+      if (from_file)
+      {
+         size_type newReserved;
+         value_type* newTypeData =
+            allocate_items(new_capacity, newReserved, trivial_items());
+         copy_items(newTypeData, items, used, trivial_items());
+         release_items();
+         items = newTypeData;
+         reserved = newReserved;
+      }
+      else
+         items = regrow_items(items, used, new_capacity, reserved,
+                              trivial_items());
       capacity = new_capacity;
-      value_type* newTypeData = new value_type[capacity];
+   }
 
-      for (size_type i = 0; i < used; i++)
-         newTypeData[i] = data[i];
+   void sequence::reserve(size_type min_capacity)
+   {
+      // Only ever grow
+      if (min_capacity > capacity)
+         resize(min_capacity);
+   }
+
+   void sequence::shrink_to_fit()
+   {
+      if (capacity > used)
+         resize(used);
+   }
 
-      // Free up memory of old array
-      delete [] data;
-      data = newTypeData;
+   void sequence::swap(sequence& other) noexcept
+   {
+      std::swap(items, other.items);
+      std::swap(used, other.used);
+      std::swap(current_index, other.current_index);
+      std::swap(capacity, other.capacity);
+      std::swap(reserved, other.reserved);
+      std::swap(from_file, other.from_file);
    }
 
    void sequence::start() { current_index = 0; }
@@ -109,68 +679,35 @@ namespace CS3358_FA2021
       current_index++;
    }
 
-   void sequence::insert(const value_type& entry)
+   void sequence::move_to(size_type index)
    {
-      // Resize if needed
-      if (used == capacity)
-         resize(int(1.5 * capacity) + 1);
-
-      if (is_item())
-      {
-         // If current index has an item,
-         // shift every item at and after
-         // the current index right,
-         // then insert the new entry at current index
-         for (size_type i = (used + 1); i > current_index; i--)
-            data[i] = data[i - 1];
+      assert(index <= used);
+      current_index = index;
+   }
 
-         data[current_index] = entry;
-      }
-      else
-      {
-         // If the current index does not
-         // have an item,
-         // insert the entry at the beginning
-         // of the sequence (index 0 of the array)
+   void sequence::insert(const value_type& entry)
+   {
+      // If there is no current item, insert the entry
+      // at the beginning of the sequence (index 0 of the array)
+      if (!is_item())
          current_index = 0;
 
-         for (size_type i = (used + 1); i > current_index; i--)
-            data[i] = data[i - 1];
-
-         data[current_index] = entry;
-      }
-      used++;
+      // Shift every item at and after the current index
+      // right, then insert the new entry at current index
+      open_gap(current_index, 1);
+      items[current_index] = entry;
    }
 
    void sequence::attach(const value_type& entry)
    {
-      // Resize if needed
-      if (used == capacity)
-         resize(int(1.5 * capacity) + 1);
-
+      // If current index has an item, the entry goes right
+      // after it; otherwise current_index == used and the
+      // entry is attached at the end of the sequence
       if (is_item())
-      {
-         // If current index has an item,
-         // shift everything after current index
-         // right, advance the current index
-         // then insert the new entry at current index
          current_index++;
-         for (size_type i = (used + 1); i > (current_index); i--)
-            data[i] = data[i - 1];
 
-         data[current_index] = entry;
-      }
-      else
-      {
-         // If the current index does not
-         // have an item,
-         // attach the entry at the end
-         // of the sequence (index 0 of the array)
-         data[current_index] = entry;
-      }
-
-      // Increment "used"
-      used++;
+      open_gap(current_index, 1);
+      items[current_index] = entry;
    }
 
    void sequence::remove_current()
@@ -180,23 +717,44 @@ namespace CS3358_FA2021
       // Shift everything after current_index left and
       // decrememnt "used" thereby removing the original
       // current item.
-      for (size_type i = current_index; i < (used - 1); i++)
-         data[i] = data[i + 1];
+      close_gap(current_index, 1);
+   }
+
+   void sequence::remove_range(size_type count)
+   {
+      assert(is_item());
 
-      used--;
+      // Don't run past the end of the sequence
+      if (count > used - current_index)
+         count = used - current_index;
+
+      close_gap(current_index, count);
    }
 
    sequence& sequence::operator=(const sequence& source)
    {
-      if (this != &source)
+      if (this == &source)
+         return *this;
+
+      if (!from_file && capacity >= source.used)
       {
-         // If the sequences are different build a new array
-         // in new memory to assign to the invoking sequence
-         value_type* newIntData = new value_type[source.capacity];
-         for (size_type i = 0; i < source.used; ++i)
-            newIntData[i] = source.data[i];
-         delete [] data;
-         data = newIntData;
+         // The items fit in the array we already own: copy them in
+         // place and keep our capacity (no allocation)
+         copy_items(items, source.items, source.used, trivial_items());
+         used = source.used;
+         current_index = source.current_index;
+      }
+      else
+      {
+         // Otherwise build a new array in new memory to assign
+         // to the invoking sequence
+         size_type newReserved;
+         value_type* newIntData =
+            allocate_items(source.capacity, newReserved, trivial_items());
+         copy_items(newIntData, source.items, source.used, trivial_items());
+         release_items();
+         reserved = newReserved;
+         items = newIntData;
          capacity = source.capacity;
          used = source.used;
          current_index = source.current_index;
@@ -205,6 +763,30 @@ namespace CS3358_FA2021
       return *this;
    }
 
+   sequence& sequence::operator=(sequence&& source) noexcept
+   {
+      if (this != &source)
+      {
+         // Free our array, take over source's and leave
+         // source empty
+         release_items();
+         items = source.items;
+         used = source.used;
+         current_index = source.current_index;
+         capacity = source.capacity;
+         reserved = source.reserved;
+         from_file = source.from_file;
+         source.items = 0;
+         source.used = 0;
+         source.current_index = 0;
+         source.capacity = 0;
+         source.reserved = 0;
+         source.from_file = false;
+      }
+
+      return *this;
+   }
+
    // CONSTANT MEMBER FUNCTIONS
    sequence::size_type sequence::size() const { return used; }
 
@@ -219,6 +801,255 @@ namespace CS3358_FA2021
    sequence::value_type sequence::current() const
    {
       assert(is_item());
-      return data[current_index];
+      return items[current_index];
+   }
+
+   // REDUCTION MEMBER FUNCTIONS
+   sequence::value_type sequence::sum() const
+   {
+      vector<value_type> parts;
+      sum_work work = { { items } };
+      split_work(used, parts, work);
+
+      value_type total = 0;
+      for (size_type k = 0; k < parts.size(); ++k)
+         total += parts[k];
+      return total;
+   }
+
+   sequence::value_type sequence::mean() const
+   {
+      assert(used > 0);
+      return sum() / used;
+   }
+
+   sequence::value_type sequence::min() const
+   {
+      assert(used > 0);
+
+      vector<value_type> parts;
+      extreme_work<false> work = { items };
+      split_work(used, parts, work);
+      return extreme<false>(&parts[0], 0, parts.size());
+   }
+
+   sequence::value_type sequence::max() const
+   {
+      assert(used > 0);
+
+      vector<value_type> parts;
+      extreme_work<true> work = { items };
+      split_work(used, parts, work);
+      return extreme<true>(&parts[0], 0, parts.size());
+   }
+
+   sequence::value_type sequence::variance() const
+   {
+      assert(used > 0);
+
+      vector<moments> parts;
+      moments_work work = { items };
+      split_work(used, parts, work);
+
+      // Combine the chunks' moments (Chan et al. pairwise update)
+      moments total = parts[0];
+      for (size_type k = 1; k < parts.size(); ++k)
+      {
+         size_type n = total.n + parts[k].n;
+         value_type delta = parts[k].mean - total.mean;
+         total.mean += delta * parts[k].n / n;
+         total.m2 += parts[k].m2 + delta * delta * total.n * parts[k].n / n;
+         total.n = n;
+      }
+      return total.m2 / total.n;
+   }
+
+   sequence::value_type sequence::dot(const sequence& other) const
+   {
+      assert(other.used == used);
+
+      vector<value_type> parts;
+      dot_work work = { { items, other.items } };
+      split_work(used, parts, work);
+
+      value_type total = 0;
+      for (size_type k = 0; k < parts.size(); ++k)
+         total += parts[k];
+      return total;
+   }
+
+   // PERSISTENCE MEMBER FUNCTIONS
+   bool sequence::save(const char* path) const
+   {
+      static_assert(is_trivially_copyable<value_type>::value,
+                    "only trivially copyable items can be saved");
+
+      file_header header;
+      memset(&header, 0, sizeof(header));
+      memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+      header.version = FILE_VERSION;
+      header.item_bytes = sizeof(value_type);
+      header.count = used;
+      header.current_index = current_index;
+      header.checksum = payload_checksum(items, used * sizeof(value_type));
+
+      // Write a temporary file and rename it over path, so that path is
+      // never truncated in place: it may be the file this (or another)
+      // sequence was loaded from, and is still mapped
+      string temp_path = string(path) + ".tmp";
+      FILE* out = fopen(temp_path.c_str(), "wb");
+      if (out == 0)
+         return false;
+      bool ok = fwrite(&header, sizeof(header), 1, out) == 1 &&
+                fwrite(items, sizeof(value_type), used, out) == used;
+      ok = (fclose(out) == 0) && ok &&
+           rename(temp_path.c_str(), path) == 0;
+      if (!ok)
+         remove(temp_path.c_str());
+      return ok;
+   }
+
+   bool sequence::load(const char* path, bool verify_checksum)
+   {
+      static_assert(is_trivially_copyable<value_type>::value,
+                    "only trivially copyable items can be loaded");
+      static_assert(sizeof(file_header) == FILE_HEADER_BYTES,
+                    "file header must be FILE_HEADER_BYTES long");
+
+      file_header header;
+      value_type* loaded;
+      size_type loadedReserved = 0;
+#ifdef SEQUENCE_MAP_LARGE_ARRAYS
+      // Map the whole file privately: pages are read on first touch and
+      // copied (never written back) on first write
+      int fd = open(path, O_RDONLY);
+      if (fd < 0)
+         return false;
+      struct stat info;
+      if (fstat(fd, &info) != 0 ||
+          size_type(info.st_size) < FILE_HEADER_BYTES)
+      {
+         close(fd);
+         return false;
+      }
+      size_type file_bytes = info.st_size;
+      void* base = mmap(0, file_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                        fd, 0);
+      close(fd);
+      if (base == MAP_FAILED)
+         return false;
+
+      memcpy(&header, base, sizeof(header));
+      loaded = reinterpret_cast<value_type*>(static_cast<char*>(base) +
+                                             FILE_HEADER_BYTES);
+      if (!valid_header(header, file_bytes) ||
+          (verify_checksum &&
+           payload_checksum(loaded, header.count * sizeof(value_type)) !=
+           header.checksum))
+      {
+         munmap(base, file_bytes);
+         return false;
+      }
+      if (header.count == 0)
+      {
+         munmap(base, file_bytes);
+         loaded = allocate_items(1, loadedReserved, trivial_items());
+      }
+      else
+         loadedReserved = header.count;
+#else
+      // No mapping available: read the file into a fresh array
+      FILE* in = fopen(path, "rb");
+      if (in == 0)
+         return false;
+      bool ok = fread(&header, sizeof(header), 1, in) == 1 &&
+                fseek(in, 0, SEEK_END) == 0;
+      long file_bytes = ok ? ftell(in) : -1;
+      ok = ok && file_bytes >= 0 &&
+           valid_header(header, file_bytes) &&
+           fseek(in, FILE_HEADER_BYTES, SEEK_SET) == 0;
+      loaded = 0;
+      if (ok)
+      {
+         loaded = allocate_items(header.count > 0 ? header.count : 1,
+                                 loadedReserved, trivial_items());
+         ok = fread(loaded, sizeof(value_type), header.count, in) ==
+              header.count &&
+              (!verify_checksum ||
+               payload_checksum(loaded, header.count * sizeof(value_type)) ==
+               header.checksum);
+      }
+      fclose(in);
+      if (!ok)
+      {
+         free_items(loaded, loadedReserved, trivial_items());
+         return false;
+      }
+#endif
+
+      // Adopt the new array
+      release_items();
+      items = loaded;
+      used = header.count;
+      capacity = (used > 0) ? used : 1;
+      reserved = loadedReserved;
+#ifdef SEQUENCE_MAP_LARGE_ARRAYS
+      from_file = (used > 0);
+#endif
+      current_index = (header.current_index < used) ? header.current_index
+                                                    : used;
+      return true;
+   }
+
+   // HELPERS
+   // Frees the item array, however it was obtained, and leaves reserved
+   // 0 and from_file false
+   void sequence::release_items()
+   {
+#ifdef SEQUENCE_MAP_LARGE_ARRAYS
+      if (from_file)
+      {
+         munmap(reinterpret_cast<char*>(items) - FILE_HEADER_BYTES,
+                FILE_HEADER_BYTES + reserved * sizeof(value_type));
+         reserved = 0;
+         from_file = false;
+         return;
+      }
+#endif
+      free_items(items, reserved, trivial_items());
+      reserved = 0;
+   }
+
+   void sequence::open_gap(size_type pos, size_type count)
+   {
+      // Grow (at most once) to hold count more items, then
+      // shift items[pos..used-1] right by count in one pass
+      if (used + count > capacity)
+      {
+         size_type needed = used + count;
+         assert(needed > used);  // count must not wrap size_type around
+
+         // Grow by half in size_type arithmetic (an int product would
+         // overflow for arrays past about 1.4 billion items); if even
+         // that wraps around, grow to just what is needed
+         size_type grown = capacity + capacity / 2 + 1;
+         if (grown < capacity)
+            grown = needed;
+         resize(grown < needed ? needed : grown);
+      }
+
+      move_items(items + pos + count, items + pos, used - pos,
+                 trivial_items());
+
+      used += count;
+   }
+
+   void sequence::close_gap(size_type pos, size_type count)
+   {
+      // Shift items[pos+count..used-1] left by count in one pass
+      move_items(items + pos, items + pos + count, used - pos - count,
+                 trivial_items());
+
+      used -= count;
    }
 }
@@ -12,10 +12,34 @@
 //    sequence::size_type is the data type of any variable that keeps
 //    track of how many items are in a sequence.
 //
+//   typedef ____ iterator
+//   typedef ____ const_iterator
+//    sequence::iterator and sequence::const_iterator are random-access
+//    iterators over the items of the sequence (in sequence order), so
+//    the sequence may be handed directly to standard algorithms
+//    (std::sort, std::accumulate, etc.).
+//
 //   static const size_type DEFAULT_CAPACITY = _____
 //    sequence::DEFAULT_CAPACITY is the default initial capacity of a
 //    sequence that is created by the default constructor.
 //
+//   static const size_type LARGE_ARRAY_BYTES = _____
+//    sequence::LARGE_ARRAY_BYTES is the array size (in bytes) at and
+//    above which a sequence of trivially copyable items is stored in
+//    an anonymous memory mapping backed by transparent huge pages
+//    (where the platform supports it) instead of the heap. Such a
+//    mapping reserves several times the requested size of address
+//    space, pages are committed only when first touched, and growth
+//    within (or past) the reservation does not copy the items. When
+//    the capacity of such a sequence is reduced (resize, shrink_to_fit)
+//    the pages past the new capacity are returned to the system, but
+//    the address space stays reserved for later growth.
+//
+//   static const size_type PARALLEL_CUTOFF = _____
+//    sequence::PARALLEL_CUTOFF is the number of items at and above
+//    which the reduction member functions (listed below) split the
+//    work across one thread per hardware core.
+//
 // CONSTRUCTOR for the sequence class:
 //   sequence(size_type initial_capacity = DEFAULT_CAPACITY)
 //    Pre:  initial_capacity > 0
@@ -24,6 +48,12 @@
 //      allocating new memory) until this capacity is reached.
 //    Note: If Pre is not met, initial_capacity will be adjusted to 1.
 //
+//   sequence(sequence&& source) noexcept
+//    Pre:  none
+//    Post: The sequence has taken over the items, current item and
+//      array of source without copying. source is left as a valid,
+//      empty sequence with no allocated array.
+//
 // MODIFICATION MEMBER FUNCTIONS for the sequence class:
 //   void resize(size_type new_capacity)
 //    Pre:  new_capacity > 0
@@ -35,6 +65,22 @@
 //      to used (in order to preserve existing data). Thereafter, if Pre
 //      is not met, new_capacity will be adjusted to 1.
 //
+//   void reserve(size_type min_capacity)
+//    Pre:  none
+//    Post: The capacity is at least min_capacity. The capacity is never
+//      reduced by this function.
+//
+//   void shrink_to_fit()
+//    Pre:  none
+//    Post: The capacity has been reduced to size() (but to no less
+//      than 1), and the memory beyond it has been given back (see
+//      LARGE_ARRAY_BYTES for mapped arrays).
+//
+//   void swap(sequence& other) noexcept
+//    Pre:  none
+//    Post: The items, current items and arrays of the two sequences
+//      have been exchanged without copying any items.
+//
 //   void start()
 //    Pre:  none
 //    Post: The first item on the sequence becomes the current item
@@ -47,6 +93,12 @@
 //      the new current item is the item immediately after the original
 //      current item.
 //
+//   void move_to(size_type index)
+//    Pre:  index <= size()
+//    Post: The item at position index (counting the first item as 0)
+//      is now the current item. If index == size(), there is no longer
+//      any current item.
+//
 //   void insert(const value_type& entry)
 //    Pre:  none
 //    Post: A new copy of entry has been inserted in the sequence
@@ -70,6 +122,44 @@
 //      item. If the current item was already the last item in the
 //      sequence, then there is no longer any current item.
 //
+//   template <class ForwardIterator>
+//   void insert_range(ForwardIterator first, ForwardIterator last)
+//    Pre:  [first, last) is a valid range of value_type items that
+//      does not refer into this sequence.
+//    Post: Copies of the items in [first, last) have been inserted, in
+//      order, before the current item (or at the front of the sequence
+//      if there was no current item). The first inserted item is now
+//      the current item. If the range is empty, nothing changes.
+//    Note: The array grows at most once and the tail is shifted once.
+//
+//   template <class ForwardIterator>
+//   void attach_range(ForwardIterator first, ForwardIterator last)
+//    Pre:  [first, last) is a valid range of value_type items that
+//      does not refer into this sequence.
+//    Post: Copies of the items in [first, last) have been inserted, in
+//      order, after the current item (or at the end of the sequence if
+//      there was no current item). The last inserted item is now the
+//      current item. If the range is empty, nothing changes.
+//    Note: The array grows at most once and the tail is shifted once.
+//
+//   void remove_range(size_type count)
+//    Pre:  is_item returns true.
+//    Post: The current item and the items after it, up to count items
+//      in all (fewer if the end of the sequence is reached), have been
+//      removed. The item after the removed items (if there is one) is
+//      now the current item; otherwise there is no current item.
+//
+//   template <class Predicate>
+//   size_type remove_if(Predicate pred)
+//    Pre:  pred may be called with a value_type and returns a value
+//      convertible to bool.
+//    Post: Every item for which pred returns true has been removed and
+//      the remaining items keep their relative order. The return value
+//      is the number of items removed. If there was a current item, the
+//      first remaining item at or after its old position is now the
+//      current item (if there is none, there is no current item).
+//    Note: The sequence is compacted in a single pass.
+//
 // CONSTANT MEMBER FUNCTIONS for the sequence class:
 //   size_type size() const
 //    Pre:  none
@@ -86,13 +176,133 @@
 //    Pre:  is_item() returns true.
 //    Post: The item returned is the current item in the sequence.
 //
+// REDUCTION MEMBER FUNCTIONS for the sequence class:
+//   (These read the item array directly, without moving the cursor.
+//    Sums use pairwise summation over blocks of four independent
+//    partial sums, which keeps the rounding error at O(log n); where
+//    SSE2 or AVX is available the four sums are kept in vector
+//    registers and added with SIMD instructions.)
+//
+//   value_type sum() const
+//    Pre:  none
+//    Post: The return value is the sum of all items (0 if empty).
+//
+//   value_type mean() const
+//    Pre:  size() > 0
+//    Post: The return value is the arithmetic mean of the items.
+//
+//   value_type min() const
+//   value_type max() const
+//    Pre:  size() > 0
+//    Post: The return value is the smallest (largest) item.
+//
+//   value_type variance() const
+//    Pre:  size() > 0
+//    Post: The return value is the population variance of the items
+//      (mean squared deviation from the mean), computed in two passes
+//      for accuracy.
+//
+//   value_type dot(const sequence& other) const
+//    Pre:  other.size() == size()
+//    Post: The return value is the sum of the products of the
+//      corresponding items of the two sequences (0 if empty).
+//
+// ITERATOR and DIRECT-ACCESS MEMBER FUNCTIONS for the sequence class:
+//   iterator begin()
+//   const_iterator begin() const
+//   const_iterator cbegin() const
+//    Pre:  none
+//    Post: The return value refers to the first item of the sequence
+//      (equal to end() if the sequence is empty).
+//
+//   iterator end()
+//   const_iterator end() const
+//   const_iterator cend() const
+//    Pre:  none
+//    Post: The return value refers to one past the last item of the
+//      sequence.
+//
+//   value_type* data()
+//   const value_type* data() const
+//    Pre:  none
+//    Post: The return value points to the contiguous array holding the
+//      items of the sequence; [data(), data() + size()) is a valid range.
+//    Note: Iterators and data() are invalidated by any function that
+//      may change the capacity (resize, insert, attach, assignment).
+//      Reordering items through them leaves the current index (not the
+//      current item) unchanged.
+//
+// PERSISTENCE MEMBER FUNCTIONS for the sequence class:
+//   (The file format is a 64-byte header holding a magic string, a
+//    format version, sizeof(value_type), the item count, the current
+//    index and a 64-bit checksum of the payload, followed by the raw
+//    items in the machine's native representation. Only sequences of
+//    trivially copyable items can be saved or loaded.)
+//
+//   bool save(const char* path) const
+//    Pre:  none
+//    Post: The items and the current index of the sequence have been
+//      written to the file named path (replacing it), and the return
+//      value is true. If the file cannot be written, the return value
+//      is false and any existing file named path is unchanged.
+//    Note: The data is written to path + ".tmp" and then renamed to
+//      path, so saving to the file a sequence was loaded from (and is
+//      still mapped) is safe.
+//
+//   bool load(const char* path, bool verify_checksum = true)
+//    Pre:  none
+//    Post: If path names a valid sequence file (and, if verify_checksum
+//      is true, its checksum matches), the sequence now holds the items
+//      and current index saved in it and the return value is true.
+//      Otherwise the sequence is unchanged and the return value is
+//      false.
+//    Note: Where memory mapping is available the file is mapped
+//      privately rather than read, so loading costs nothing per item
+//      (unless verify_checksum is true, which reads every page once).
+//      Writing an item copies just the page holding it, and the first
+//      change of capacity (e.g. an insert into the full array) copies
+//      the items into ordinary memory; the file itself is never
+//      modified.
+//
+// NESTED CLASS sequence::cursor:
+//   A cursor is a lightweight, independent read position bound to one
+//   sequence. Any number of cursors may traverse the same sequence
+//   without copying it and without disturbing the sequence's own
+//   current item. Cursors only read the sequence, so several threads
+//   may each use their own cursors over a shared sequence at the same
+//   time, provided no thread modifies the sequence meanwhile.
+//
+//   explicit cursor(const sequence& source)
+//    Pre:  none
+//    Post: The cursor is bound to source and positioned at its first
+//      item (if source is empty, there is no current item).
+//    Note: The cursor must not outlive source.
+//
+//   void start()
+//   void advance()
+//   bool is_item() const
+//   value_type current() const
+//    Same as the sequence functions of the same names, but acting on
+//    the cursor's own position.
+//
+// NONMEMBER FUNCTIONS for the sequence class:
+//   void swap(sequence& a, sequence& b) noexcept
+//    Post: Same as a.swap(b).
+//
 // VALUE SEMANTICS for the sequence class:
 //   Assignments and the copy constructor may be used with sequence
-//   objects.
+//   objects. Copy assignment reuses the target's own array when the
+//   source's items fit in it (the target keeps its capacity), and
+//   allocates a new array (with the source's capacity) otherwise or if
+//   the target is mapped from a file. Move construction and move
+//   assignment transfer ownership of the array and leave the source as
+//   an empty sequence.
 
 #ifndef SEQUENCE_H
 #define SEQUENCE_H
+#include <cassert>  // provides assert
 #include <cstdlib>  // provides size_t
+#include <iterator> // provides std::distance
 
 namespace CS3358_FA2021
 {
@@ -102,29 +312,145 @@ namespace CS3358_FA2021
       // TYPEDEFS and MEMBER CONSTANTS
       typedef double value_type;
       typedef std::size_t size_type;
+      typedef value_type* iterator;
+      typedef const value_type* const_iterator;
+      class cursor;
       static const size_type DEFAULT_CAPACITY = 30;
+      static const size_type LARGE_ARRAY_BYTES = 64 * 1024 * 1024;
+      static const size_type PARALLEL_CUTOFF = 1 << 20;
       // CONSTRUCTORS and DESTRUCTOR
       sequence(size_type initial_capacity = DEFAULT_CAPACITY);
       sequence(const sequence& source);
+      sequence(sequence&& source) noexcept;
       ~sequence();
       // MODIFICATION MEMBER FUNCTIONS
       void resize(size_type new_capacity);
+      void reserve(size_type min_capacity);
+      void shrink_to_fit();
+      void swap(sequence& other) noexcept;
       void start();
       void advance();
+      void move_to(size_type index);
       void insert(const value_type& entry);
       void attach(const value_type& entry);
       void remove_current();
+      template <class ForwardIterator>
+      void insert_range(ForwardIterator first, ForwardIterator last);
+      template <class ForwardIterator>
+      void attach_range(ForwardIterator first, ForwardIterator last);
+      void remove_range(size_type count);
+      template <class Predicate>
+      size_type remove_if(Predicate pred);
       sequence& operator=(const sequence& source);
+      sequence& operator=(sequence&& source) noexcept;
       // CONSTANT MEMBER FUNCTIONS
       size_type size() const;
       bool is_item() const;
       value_type current() const;
+      // REDUCTION MEMBER FUNCTIONS
+      value_type sum() const;
+      value_type mean() const;
+      value_type min() const;
+      value_type max() const;
+      value_type variance() const;
+      value_type dot(const sequence& other) const;
+      // PERSISTENCE MEMBER FUNCTIONS
+      bool save(const char* path) const;
+      bool load(const char* path, bool verify_checksum = true);
+      // ITERATOR and DIRECT-ACCESS MEMBER FUNCTIONS
+      iterator begin() { return items; }
+      const_iterator begin() const { return items; }
+      const_iterator cbegin() const { return items; }
+      iterator end() { return items + used; }
+      const_iterator end() const { return items + used; }
+      const_iterator cend() const { return items + used; }
+      value_type* data() { return items; }
+      const value_type* data() const { return items; }
    private:
-      value_type* data;
+      value_type* items;
       size_type used;
       size_type current_index;
       size_type capacity;
+      size_type reserved;
+      bool from_file;
+      // HELPERS
+      void release_items();
+      void open_gap(size_type pos, size_type count);
+      void close_gap(size_type pos, size_type count);
    };
+
+   class sequence::cursor
+   {
+   public:
+      explicit cursor(const sequence& source) : seq(&source), index(0) { }
+      void start() { index = 0; }
+      void advance() { assert(is_item()); ++index; }
+      bool is_item() const { return index < seq->used; }
+      value_type current() const
+      {
+         assert(is_item());
+         return seq->items[index];
+      }
+   private:
+      const sequence* seq;
+      size_type index;
+   };
+
+   // NONMEMBER FUNCTIONS
+   inline void swap(sequence& a, sequence& b) noexcept { a.swap(b); }
+
+   // MEMBER TEMPLATES (must be visible to every caller)
+   template <class ForwardIterator>
+   void sequence::insert_range(ForwardIterator first, ForwardIterator last)
+   {
+      size_type count = std::distance(first, last);
+      if (count == 0)
+         return;
+
+      if (!is_item())
+         current_index = 0;
+      open_gap(current_index, count);
+      for (size_type i = current_index; first != last; ++first, ++i)
+         items[i] = *first;
+   }
+
+   template <class ForwardIterator>
+   void sequence::attach_range(ForwardIterator first, ForwardIterator last)
+   {
+      size_type count = std::distance(first, last);
+      if (count == 0)
+         return;
+
+      size_type pos = is_item() ? current_index + 1 : used;
+      open_gap(pos, count);
+      for (size_type i = pos; first != last; ++first, ++i)
+         items[i] = *first;
+      current_index = pos + count - 1;
+   }
+
+   template <class Predicate>
+   sequence::size_type sequence::remove_if(Predicate pred)
+   {
+      // Slide each kept item down over the removed ones; the new
+      // current item is the first item kept at or after the old one.
+      size_type kept = 0;
+      size_type new_current = used;
+      for (size_type i = 0; i < used; ++i)
+      {
+         if (pred(items[i]))
+            continue;
+         if (i >= current_index && new_current == used)
+            new_current = kept;
+         if (kept != i)
+            items[kept] = items[i];
+         ++kept;
+      }
+
+      size_type removed = used - kept;
+      current_index = (new_current == used) ? kept : new_current;
+      used = kept;
+      return removed;
+   }
 }
 
 #endif
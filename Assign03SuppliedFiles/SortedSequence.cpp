@@ -0,0 +1,116 @@
+// FILE: SortedSequence.cpp
+// CLASS IMPLEMENTED: sorted_sequence (see SortedSequence.h for
+//                    documentation)
+// INVARIANT for the sorted_sequence class:
+//   1. The items are stored in the sequence storage, in ascending order
+//      (each item is <= the item after it).
+//   2. The current item of the sorted_sequence is the current item of
+//      storage.
+
+#include <algorithm>  // provides std::lower_bound, std::upper_bound
+#include "SortedSequence.h"
+
+namespace CS3358_FA2021
+{
+   sorted_sequence::sorted_sequence(size_type initial_capacity) :
+      storage(initial_capacity)
+   { }
+
+   // MODIFICATION MEMBER FUNCTIONS
+   void sorted_sequence::start() { storage.start(); }
+
+   void sorted_sequence::advance() { storage.advance(); }
+
+   void sorted_sequence::remove_current() { storage.remove_current(); }
+
+   void sorted_sequence::insert(const value_type& entry)
+   {
+      // Insert after any equal items, so equal items keep the order in
+      // which they were inserted
+      const_iterator spot = std::upper_bound(storage.begin(), storage.end(), entry);
+      storage.move_to(spot - storage.cbegin());
+
+      // With no current item, insert would go to the front, so an
+      // entry belonging at the end is attached instead
+      if (storage.is_item())
+         storage.insert(entry);
+      else
+         storage.attach(entry);
+   }
+
+   bool sorted_sequence::find(const value_type& target)
+   {
+      if (lower_bound(target) && !(target < storage.current()))
+         return true;
+
+      storage.move_to(storage.size());
+      return false;
+   }
+
+   bool sorted_sequence::lower_bound(const value_type& target)
+   {
+      const_iterator spot = std::lower_bound(storage.cbegin(), storage.cend(),
+                                             target);
+      storage.move_to(spot - storage.cbegin());
+      return storage.is_item();
+   }
+
+   void sorted_sequence::merge(const sorted_sequence& other)
+   {
+      // Merging with ourselves would read items we are overwriting
+      if (&other == this)
+      {
+         sorted_sequence copy(other);
+         merge(copy);
+         return;
+      }
+
+      size_type mine = storage.size(),
+                theirs = other.size();
+      if (theirs == 0)
+      {
+         storage.move_to(mine);
+         return;
+      }
+
+      // Open room for other's items at the end (growing at most once),
+      // then merge from the back so nothing is overwritten before it
+      // has been moved into place
+      storage.move_to(mine);
+      storage.attach_range(other.begin(), other.end());
+
+      value_type* out = storage.data() + mine + theirs;
+      const value_type* a = storage.data() + mine;
+      const value_type* b = other.storage.data() + theirs;
+      const value_type* a_first = storage.data();
+      const value_type* b_first = other.storage.data();
+      while (b != b_first)
+      {
+         // Ties take other's item first (from the back), which leaves
+         // our equal items in front of it
+         if (a != a_first && *(b - 1) < *(a - 1))
+            *--out = *--a;
+         else
+            *--out = *--b;
+      }
+
+      storage.move_to(storage.size());
+   }
+
+   // CONSTANT MEMBER FUNCTIONS
+   sorted_sequence::size_type sorted_sequence::size() const
+   { return storage.size(); }
+
+   bool sorted_sequence::is_item() const { return storage.is_item(); }
+
+   sorted_sequence::value_type sorted_sequence::current() const
+   { return storage.current(); }
+
+   sorted_sequence::const_iterator sorted_sequence::begin() const
+   { return storage.begin(); }
+
+   sorted_sequence::const_iterator sorted_sequence::end() const
+   { return storage.end(); }
+
+   const sequence& sorted_sequence::items() const { return storage; }
+}
@@ -0,0 +1,108 @@
+// FILE: SortedSequence.h
+// CLASS PROVIDED: sorted_sequence (part of the namespace CS3358_FA2021)
+//
+// A sorted_sequence is a sequence (see Sequence.h) whose items are
+// always kept in ascending order. Items are placed by binary search,
+// and finding a value positions the cursor in O(log n) instead of
+// stepping through the sequence from the start. Only operations that
+// cannot break the ordering are offered.
+//
+// TYPEDEFS and MEMBER CONSTANTS for the sorted_sequence class:
+//   typedef ____ value_type
+//   typedef ____ size_type
+//   typedef ____ const_iterator
+//    As for sequence.
+//
+// CONSTRUCTOR for the sorted_sequence class:
+//   sorted_sequence(size_type initial_capacity =
+//                   sequence::DEFAULT_CAPACITY)
+//    Pre:  none
+//    Post: The sorted_sequence has been initialized as an empty
+//      sequence with the given initial capacity.
+//
+// MODIFICATION MEMBER FUNCTIONS for the sorted_sequence class:
+//   void start()
+//   void advance()
+//   void remove_current()
+//    As for sequence.
+//
+//   void insert(const value_type& entry)
+//    Pre:  none
+//    Post: A new copy of entry has been inserted after any items less
+//      than or equal to it and before any items greater than it. The
+//      newly inserted item is now the current item.
+//
+//   bool find(const value_type& target)
+//    Pre:  none
+//    Post: If target is in the sequence, the return value is true and
+//      the first item equal to target is now the current item.
+//      Otherwise the return value is false and there is no current item.
+//
+//   bool lower_bound(const value_type& target)
+//    Pre:  none
+//    Post: The first item that is not less than target is now the
+//      current item, and the return value is true. If every item is
+//      less than target, the return value is false and there is no
+//      current item.
+//
+//   void merge(const sorted_sequence& other)
+//    Pre:  none
+//    Post: Copies of all of other's items have been added to the
+//      sequence, which remains in ascending order (items of other come
+//      after equal items already in the sequence). There is no current
+//      item. The merge takes time linear in size() + other.size().
+//
+// CONSTANT MEMBER FUNCTIONS for the sorted_sequence class:
+//   size_type size() const
+//   bool is_item() const
+//   value_type current() const
+//   const_iterator begin() const
+//   const_iterator end() const
+//    As for sequence.
+//
+//   const sequence& items() const
+//    Pre:  none
+//    Post: The return value refers to the underlying sequence (for use
+//      with its reduction functions and cursors).
+//
+// VALUE SEMANTICS for the sorted_sequence class:
+//   Assignments and the copy constructor may be used with
+//   sorted_sequence objects.
+
+#ifndef SORTED_SEQUENCE_H
+#define SORTED_SEQUENCE_H
+#include "Sequence.h"
+
+namespace CS3358_FA2021
+{
+   class sorted_sequence
+   {
+   public:
+      // TYPEDEFS
+      typedef sequence::value_type value_type;
+      typedef sequence::size_type size_type;
+      typedef sequence::const_iterator const_iterator;
+      // CONSTRUCTOR
+      sorted_sequence(size_type initial_capacity =
+                         sequence::DEFAULT_CAPACITY);
+      // MODIFICATION MEMBER FUNCTIONS
+      void start();
+      void advance();
+      void remove_current();
+      void insert(const value_type& entry);
+      bool find(const value_type& target);
+      bool lower_bound(const value_type& target);
+      void merge(const sorted_sequence& other);
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      bool is_item() const;
+      value_type current() const;
+      const_iterator begin() const;
+      const_iterator end() const;
+      const sequence& items() const;
+   private:
+      sequence storage;
+   };
+}
+
+#endif
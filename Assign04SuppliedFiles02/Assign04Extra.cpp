@@ -0,0 +1,695 @@
+// FILE: Assign04Extra.cpp
+// A non-interactive test program for the extensions of the sequence class
+// template (see sequence.h) and for ring_sequence (see ring_sequence.h).
+//
+// DESCRIPTION:
+// Each function of this program tests part of these classes, returning
+// some number of points to indicate how much of the test was passed.
+// A description and result of each test is printed to cout.
+// Maximum number of points awarded by this program is determined by the
+// constants POINTS[1], POINTS[2]...
+
+#include <iostream>         // provides cout.
+#include <algorithm>        // provides std::sort, std::equal.
+#include <cstdlib>          // provides size_t, rand, srand.
+#include <functional>       // provides std::greater.
+#include <string>           // provides std::string.
+#include <utility>          // provides std::move.
+#include "sequence.h"       // provides the sequence class template.
+#include "ring_sequence.h"  // provides the ring_sequence class template.
+using namespace std;
+using namespace CS3358_FA2021_A04;
+
+// Descriptions and points for each of the tests:
+const size_t MANY_TESTS = 5;
+const int POINTS[MANY_TESTS+1] =
+{
+    13,  // Total points for all tests.
+     2,  // Test 1 points
+     2,  // Test 2 points
+     3,  // Test 3 points
+     3,  // Test 4 points
+     3   // Test 5 points
+};
+const char DESCRIPTION[MANY_TESTS+1][256] =
+{
+    "tests for the sequence extensions",
+    "Testing items_begin, items_end and data with standard algorithms",
+    "Testing the copy constructor and assignment",
+    "Testing moved, emplaced and self-referencing string items",
+    "Testing find, find_any and count",
+    "Testing ring_sequence against sequence"
+};
+
+
+// **************************************************************************
+// template <class Item, size_t N>
+// bool same_items(const sequence<Item, N>& test, const Item items[], size_t s)
+//   Postcondition: The return value is true if test has exactly s items
+//   and they are equal to items[0] ... items[s-1]; otherwise false.
+//   The current item of test is not moved.
+// **************************************************************************
+template <class Item, size_t N>
+bool same_items(const sequence<Item, N>& test, const Item items[], size_t s)
+{
+    if (test.size() != s)
+        return false;
+    for (size_t i = 0; i < s; i++)
+        if (!(test.data()[i] == items[i]))
+            return false;
+    return true;
+}
+
+
+// **************************************************************************
+// template <class Item, size_t N, class Ring>
+// bool same_ring(const Ring& test, const sequence<Item, N>& model)
+//   Postcondition: The return value is true if test and model hold the same
+//   items in the same order and have the current item at the same place;
+//   otherwise false. Copies are walked, so neither cursor is moved.
+// **************************************************************************
+template <class Item, size_t N, class Ring>
+bool same_ring(const Ring& test, const sequence<Item, N>& model)
+{
+    if (test.size() != model.size() || test.is_item() != model.is_item())
+        return false;
+    if (test.is_item() && !(test.current() == model.current()))
+        return false;
+
+    Ring walk(test);
+    size_t i = 0;
+    for (walk.start(); walk.is_item(); walk.advance(), i++)
+        if (!(walk.current() == model.data()[i]))
+            return false;
+    return i == model.size();
+}
+
+
+// **************************************************************************
+// int test1()
+//   Performs tests of items_begin, items_end and data by running standard
+//   algorithms over the items, both while they are in the inline storage
+//   and after they have spilled to the heap.
+//   Returns POINTS[1] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test1()
+{
+    int input[6] = { 50, 10, 40, 20, 60, 30 };
+    int sorted[6] = { 10, 20, 30, 40, 50, 60 };
+    int reversed[6] = { 60, 50, 40, 30, 20, 10 };
+    int many[25];
+    sequence<int> test;
+    sequence<int, 4> small;
+    size_t i;
+
+    cout << "Sorting 50, 10, 40, 20, 60, 30 with std::sort(items_begin(), items_end()) ...";
+    cout.flush();
+    for (i = 0; i < 6; i++)
+        test.add(input[i]);
+    test.start();
+    test.advance();
+    test.advance();
+    sort(test.items_begin(), test.items_end());
+    if (!same_items(test, sorted, 6) || test.items_end() - test.items_begin() != 6)
+    {
+        cout << " the items are not in ascending order." << endl;
+        return 0;
+    }
+    if (!test.is_item() || test.current() != 30)
+    {
+        cout << " the current index moved." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Sorting descending with std::sort(data(), data() + size()) ...";
+    cout.flush();
+    sort(test.data(), test.data() + test.size(), greater<int>());
+    if (!same_items(test, reversed, 6) || test.current() != 40)
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Sorting 25 items that have spilled out of the inline storage ...";
+    cout.flush();
+    for (i = 0; i < 25; i++)
+    {
+        many[i] = int(i);
+        small.add(int((i * 7) % 25));
+    }
+    sort(small.items_begin(), small.items_end());
+    if (!same_items(small, many, 25))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Comparing the const iterators with std::equal ...";
+    cout.flush();
+    const sequence<int, 4>& view = small;
+    if (!equal(view.items_begin(), view.items_end(), many)
+        || !equal(small.cbegin(), small.cend(), view.data())
+        || view.items_begin() != view.data())
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this first function have been passed." << endl;
+    return POINTS[1];
+}
+
+
+// **************************************************************************
+// template <class Item, size_t N>
+// bool held_inline(const sequence<Item, N>& test)
+//   Postcondition: The return value is true if the items of test are in
+//   its inline storage (inside the sequence object); otherwise false.
+// **************************************************************************
+template <class Item, size_t N>
+bool held_inline(const sequence<Item, N>& test)
+{
+    const char* object = reinterpret_cast<const char*>(&test);
+    const char* items = reinterpret_cast<const char*>(test.data());
+    return items >= object && items < object + sizeof(test);
+}
+
+// **************************************************************************
+// int test2()
+//   Performs tests of the copy constructor and assignment operator with
+//   sources that do and do not fit in the inline storage.
+//   Returns POINTS[2] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test2()
+{
+    int few[3] = { 1, 2, 3 };
+    int many[9];
+    sequence<int, 4> small, large, target;
+    size_t i;
+
+    for (i = 0; i < 3; i++)
+        small.add(few[i]);
+    small.start();
+    for (i = 0; i < 9; i++)
+    {
+        many[i] = int(10 * i);
+        large.add(many[i]);
+    }
+
+    cout << "Copying 3 and 9 items into sequences with 4 inline slots ...";
+    cout.flush();
+    sequence<int, 4> small_copy(small), large_copy(large);
+    if (!same_items(small_copy, few, 3) || !held_inline(small_copy)
+        || small_copy.current() != 1
+        || !same_items(large_copy, many, 9) || held_inline(large_copy))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Assigning 9 items, then 3 items, to the same sequence ...";
+    cout.flush();
+    target = large;
+    if (!same_items(target, many, 9) || held_inline(target)
+        || target.current() != 80)
+    {
+        cout << " assigning 9 items failed." << endl;
+        return 0;
+    }
+    target = small;
+    if (!same_items(target, few, 3) || target.current() != 1)
+    {
+        cout << " assigning 3 items failed." << endl;
+        return 0;
+    }
+    if (!held_inline(target))
+    {
+        cout << " the items were not moved back to the inline storage." << endl;
+        return 0;
+    }
+    target.end();
+    target.add(4);
+    target.add(5);
+    int grown[5] = { 1, 2, 3, 4, 5 };
+    if (!same_items(target, grown, 5) || held_inline(target)
+        || !same_items(small, few, 3))
+    {
+        cout << " the sequence did not spill again afterwards." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this second function have been passed." << endl;
+    return POINTS[2];
+}
+
+
+// **************************************************************************
+// int test3()
+//   Performs tests of add(value_type&&), emplace, current_ref and of add
+//   given one of the sequence's own items, with std::string items (which
+//   are not trivially copyable).
+//   Returns POINTS[3] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test3()
+{
+    // Longer than any short-string buffer, so a moved-from string is
+    // left without its characters
+    const string ALPHA = "alpha alpha alpha alpha alpha";
+    const string BETA = "beta beta beta beta beta beta";
+    const string GAMMA = "gamma gamma gamma gamma gamma";
+    sequence<string, 2> test;
+
+    cout << "Adding moved strings ...";
+    cout.flush();
+    string moved = ALPHA;
+    test.add(std::move(moved));
+    moved = BETA;
+    test.add(std::move(moved));
+    string two[2] = { ALPHA, BETA };
+    if (!same_items(test, two, 2) || test.current() != BETA)
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Emplacing string(5, 'x') and string(\"gamma ...\") ...";
+    cout.flush();
+    test.emplace(size_t(5), 'x');
+    test.emplace(GAMMA.c_str());
+    string four[4] = { ALPHA, BETA, "xxxxx", GAMMA };
+    if (!same_items(test, four, 4) || test.current() != GAMMA)
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Testing current_ref ...";
+    cout.flush();
+    test.start();
+    test.advance();
+    const string& ref = test.current_ref();
+    if (&ref != test.data() + 1 || ref != BETA || ref != test.current())
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Adding copies of the sequence's own items ...";
+    cout.flush();
+    test.start();
+    test.add(test.data()[3]);   // shifting the tail moves GAMMA away
+    string five[5] = { ALPHA, GAMMA, BETA, "xxxxx", GAMMA };
+    if (!same_items(test, five, 5) || test.current() != GAMMA)
+    {
+        cout << " failed when the item was shifted." << endl;
+        return 0;
+    }
+    while (test.size() < 8)
+        test.add("filler");
+    test.start();
+    test.add(test.current_ref());   // the array is full, so it grows
+    if (test.size() != 9 || test.data()[0] != ALPHA
+        || test.data()[1] != ALPHA || test.current() != ALPHA)
+    {
+        cout << " failed when the array grew." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this third function have been passed." << endl;
+    return POINTS[3];
+}
+
+
+// **************************************************************************
+// template <class Item, size_t N>
+// size_t first_of(const sequence<Item, N>& test, size_t from,
+//                 const Item set[], size_t set_size)
+//   Postcondition: The return value is the position of the first item of
+//   test at or after position from that equals one of set[0] through
+//   set[set_size-1], or test.size() if there is none.
+// **************************************************************************
+template <class Item, size_t N>
+size_t first_of(const sequence<Item, N>& test, size_t from,
+                const Item set[], size_t set_size)
+{
+    for (size_t i = from; i < test.size(); i++)
+        for (size_t j = 0; j < set_size; j++)
+            if (test.data()[i] == set[j])
+                return i;
+    return test.size();
+}
+
+// **************************************************************************
+// int test4()
+//   Performs tests of find, find_any and count on sequence<char> (whose
+//   versions use memchr, or a table for sets of more than 4 characters)
+//   and sequence<int>, including searches with no current item and with
+//   an empty set.
+//   Returns POINTS[4] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test4()
+{
+    const char TEXT[] = "the quick brown fox jumps over the lazy dog\xe9!";
+    const size_t SEARCHES = 20000;
+    sequence<char> text;
+    sequence<int> numbers;
+    size_t i;
+
+    for (i = 0; TEXT[i] != '\0'; i++)
+    {
+        text.end();
+        text.add(TEXT[i]);
+    }
+
+    cout << "Testing find and count on sequence<char> ...";
+    cout.flush();
+    text.start();
+    if (!text.find('o') || text.current() != 'o' || text.current_ref() != TEXT[12]
+        || &text.current_ref() != text.data() + 12)
+    {
+        cout << " find('o') did not stop at the first o." << endl;
+        return 0;
+    }
+    text.advance();
+    if (!text.find('o') || &text.current_ref() != text.data() + 17)
+    {
+        cout << " find('o') did not continue from the current item." << endl;
+        return 0;
+    }
+    if (text.find('Q') || text.is_item())
+    {
+        cout << " found Q, which is not in the sequence." << endl;
+        return 0;
+    }
+    if (text.find('t') || text.is_item())
+    {
+        cout << " found an item with no current item to search from." << endl;
+        return 0;
+    }
+    if (text.count('o') != 4 || text.count(' ') != 8 || text.count('\xe9') != 1
+        || text.count('Q') != 0)
+    {
+        cout << " count returned a wrong number." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Testing find_any on sequence<char> with small and large sets ...";
+    cout.flush();
+    const char vowels[5] = { 'a', 'e', 'i', 'o', 'u' };
+    const char marks[2] = { '!', 'z' };
+    const char accents[6] = { '\xe0', '\xe8', '\xe9', '\xea', '\xf4', '!' };
+    text.start();
+    if (!text.find_any(vowels, 4) || &text.current_ref() != text.data() + 2)
+    {
+        cout << " failed with 4 characters." << endl;
+        return 0;
+    }
+    text.advance();
+    if (!text.find_any(vowels, 5) || &text.current_ref() != text.data() + 5)
+    {
+        cout << " failed with 5 characters." << endl;
+        return 0;
+    }
+    if (!text.find_any(marks, 2) || text.current() != 'z')
+    {
+        cout << " failed with 2 characters." << endl;
+        return 0;
+    }
+    if (!text.find_any(accents, 6) || text.current() != '\xe9')
+    {
+        cout << " failed with characters above 127." << endl;
+        return 0;
+    }
+    text.start();
+    if (text.find_any(vowels, 0) || text.is_item())
+    {
+        cout << " found an item in an empty set." << endl;
+        return 0;
+    }
+    if (text.find_any(vowels, 5) || text.is_item())
+    {
+        cout << " found an item with no current item to search from." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Comparing " << SEARCHES << " random find_any calls with a plain search ...";
+    cout.flush();
+    srand(3358);
+    for (i = 0; i < SEARCHES; i++)
+    {
+        char set[8];
+        size_t set_size = rand() % 9;
+        for (size_t j = 0; j < set_size; j++)
+            set[j] = TEXT[rand() % (sizeof(TEXT) - 1)] + rand() % 2;
+        size_t from = rand() % (text.size() + 1);
+        text.start();
+        for (size_t j = 0; j < from; j++)
+            text.advance();
+        size_t expected = first_of(text, from, set, set_size);
+        bool found = text.find_any(set, set_size);
+        if (found != (expected < text.size())
+            || (found ? &text.current_ref() != text.data() + expected
+                      : text.is_item()))
+        {
+            cout << " failed for a set of " << set_size << " characters." << endl;
+            return 0;
+        }
+    }
+    cout << " passed." << endl;
+
+    cout << "Testing find, find_any and count on sequence<int> ...";
+    cout.flush();
+    for (i = 0; i < 30; i++)
+        numbers.add(int(i % 7));   // 0 1 ... 6 0 1 ... (each after the last)
+    const int wanted[3] = { 9, 5, 4 };
+    numbers.start();
+    if (numbers.count(3) != 4 || numbers.count(1) != 5 || numbers.count(9) != 0
+        || !numbers.find(6) || &numbers.current_ref() != numbers.data() + 6)
+    {
+        cout << " find or count failed." << endl;
+        return 0;
+    }
+    numbers.advance();
+    if (!numbers.find_any(wanted, 3) || &numbers.current_ref() != numbers.data() + 11
+        || numbers.find_any(wanted, 0) || numbers.is_item()
+        || numbers.find(0) || numbers.is_item())
+    {
+        cout << " find_any failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this fourth function have been passed." << endl;
+    return POINTS[4];
+}
+
+
+// **************************************************************************
+// int test5()
+//   Applies the same random cursor moves, adds and removals to a
+//   ring_sequence and a sequence (both holding 4 items inline, so that
+//   they spill to the heap and grow) and checks after each one that the
+//   two agree. Returns POINTS[5] if the tests are passed. Otherwise
+//   returns 0.
+// **************************************************************************
+int test5()
+{
+    const size_t OPERATIONS = 200000;
+    const size_t MOST = 40;
+    ring_sequence<int, 4> test;
+    sequence<int, 4> model;
+    size_t i;
+
+    cout << "Adding " << MOST << " items at the front, then removing them from the back ...";
+    cout.flush();
+    for (i = 0; i < MOST; i++)
+    {
+        test.add(int(i));
+        model.add(int(i));
+        test.start();
+        model.start();
+        test.move_back();
+        model.move_back();
+    }
+    if (!same_ring(test, model))
+    {
+        cout << " adding at the front failed." << endl;
+        return 0;
+    }
+    while (model.size() > 0)
+    {
+        test.end();
+        model.end();
+        test.remove_current();
+        model.remove_current();
+        if (!same_ring(test, model))
+        {
+            cout << " removing the last item failed." << endl;
+            return 0;
+        }
+    }
+    cout << " passed." << endl;
+
+    cout << "Comparing " << OPERATIONS << " random operations with sequence ...";
+    cout.flush();
+    srand(3358);
+    for (i = 0; i < OPERATIONS; i++)
+    {
+        int item = rand() % 1000;
+        switch (rand() % 8)
+        {
+        case 0:
+            test.start();
+            model.start();
+            break;
+        case 1:
+            test.end();
+            model.end();
+            break;
+        case 2:
+            if (model.is_item())
+            {
+                test.advance();
+                model.advance();
+            }
+            break;
+        case 3:
+            if (model.is_item())
+            {
+                test.move_back();
+                model.move_back();
+            }
+            break;
+        case 4:
+        case 5:
+        case 6:
+            if (model.size() < MOST)
+            {
+                test.add(item);
+                model.add(item);
+            }
+            break;
+        default:
+            if (model.is_item())
+            {
+                test.remove_current();
+                model.remove_current();
+            }
+        }
+        if (!same_ring(test, model))
+        {
+            cout << " failed at operation " << i << "." << endl;
+            return 0;
+        }
+    }
+    cout << " passed." << endl;
+
+    cout << "Testing the copy constructor and assignment ...";
+    cout.flush();
+    ring_sequence<int, 4> copy(test);
+    ring_sequence<int, 4> assigned;
+    assigned.add(-1);
+    assigned = test;
+    if (!same_ring(copy, model) || !same_ring(assigned, model))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Assigning 3 items to a ring_sequence that has spilled ...";
+    cout.flush();
+    ring_sequence<int, 4> few;
+    sequence<int, 4> few_model;
+    for (i = 0; i < 3; i++)
+    {
+        few.add(int(i));
+        few_model.add(int(i));
+    }
+    while (assigned.size() <= 4)
+        assigned.add(0);
+    assigned = few;
+    copy = assigned;
+    if (!same_ring(assigned, few_model) || !same_ring(copy, few_model))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    for (i = 0; i < 6; i++)
+    {
+        assigned.add(int(10 + i));
+        few_model.add(int(10 + i));
+    }
+    if (!same_ring(assigned, few_model) || copy.size() != 3)
+    {
+        cout << " the assigned ring_sequence did not grow again." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this fifth function have been passed." << endl;
+    return POINTS[5];
+}
+
+int run_a_test(int number, const char message[], int test_function(), int max)
+{
+    int result;
+
+    cout << endl << "START OF TEST " << number << ":" << endl;
+    cout << message << " (" << max << " points)." << endl;
+    result = test_function();
+    if (result > 0)
+    {
+        cout << "Test " << number << " got " << result << " points";
+        cout << " out of a possible " << max << "." << endl;
+    }
+    else
+        cout << "Test " << number << " failed." << endl;
+    cout << "END OF TEST " << number << "." << endl << endl;
+
+    return result;
+}
+
+
+// **************************************************************************
+// int main()
+//   The main program calls all tests and prints the sum of all points
+//   earned from the tests.
+// **************************************************************************
+int main()
+{
+    int sum = 0;
+
+
+    cout << "Running " << DESCRIPTION[0] << endl;
+
+    sum += run_a_test(1, DESCRIPTION[1], test1, POINTS[1]);
+    sum += run_a_test(2, DESCRIPTION[2], test2, POINTS[2]);
+    sum += run_a_test(3, DESCRIPTION[3], test3, POINTS[3]);
+    sum += run_a_test(4, DESCRIPTION[4], test4, POINTS[4]);
+    sum += run_a_test(5, DESCRIPTION[5], test5, POINTS[5]);
+
+    cout << "The sequence extensions have scored\n";
+    cout << sum << " points out of the " << POINTS[0];
+    cout << " points based on this test program.\n";
+
+    return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,108 @@
+// FILE: ring_sequence.h
+// CLASS PROVIDED: ring_sequence (a container class for a list of items,
+//                 where each list may have a designated item called
+//                 the current item; a variant of sequence in sequence.h)
+//
+// A ring_sequence stores its items in a circular buffer: the first item
+// may sit anywhere in the array, and the items wrap around from the
+// last slot to slot 0. Adding a new first item or removing the first or
+// last item therefore moves no other items, and an add or remove in the
+// middle moves only the items on whichever side of it is shorter.
+// Use it in place of sequence when items are mostly added at the front.
+//
+// Like sequence, a ring_sequence holds up to N items inside the object
+// itself and moves them to a heap array, which grows as needed, when
+// more are added. It offers only the members listed below (no add of
+// an rvalue, emplace, current_ref, find, find_any, count, iterators or
+// data(), since the items need not be contiguous).
+//
+// TEMPLATE PARAMETERS for the ring_sequence class:
+//   class Item
+//   size_t N (default 10)
+//     As for sequence.
+//
+// TYPEDEFS and MEMBER CONSTANTS for the ring_sequence class:
+//   typedef ____ value_type
+//   typedef ____ size_type
+//   static const size_type CAPACITY = N
+//     As for sequence.
+//
+// CONSTRUCTOR for the ring_sequence class:
+//   ring_sequence()
+//     Pre:  (none)
+//     Post: The ring_sequence has been initialized as an empty sequence.
+//
+// MODIFICATION MEMBER FUNCTIONS for the ring_sequence class:
+//   void start()
+//   void end()
+//   void advance()
+//   void move_back()
+//   void add(const value_type& entry)
+//   void remove_current()
+//     As for sequence. start, end, advance and move_back take constant
+//     time; add as the new first item (no current item) and removal of
+//     the first or last item take constant time as well (apart from the
+//     occasional add that moves the items to a larger array).
+//
+// CONSTANT MEMBER FUNCTIONS for the ring_sequence class:
+//   size_type size() const
+//   bool is_item() const
+//   value_type current() const
+//     As for sequence.
+//
+// VALUE SEMANTICS for the ring_sequence class:
+//    Assignments and the copy constructor may be used with ring_sequence
+//    objects, as for sequence. A copy holds its items unwrapped (the
+//    first item in the first slot).
+
+#ifndef RING_SEQUENCE_H
+#define RING_SEQUENCE_H
+
+#include <cstdlib>  // provides size_t
+
+namespace CS3358_FA2021_A04
+{
+   template<class Item, size_t N = 10>
+   class ring_sequence
+   {
+      static_assert(N > 0, "ring_sequence needs room for at least one inline item");
+
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef Item value_type;
+      typedef size_t size_type;
+      static const size_type CAPACITY = N;
+      // CONSTRUCTORS and DESTRUCTOR
+      ring_sequence();
+      ring_sequence(const ring_sequence& source);
+      ~ring_sequence();
+      // MODIFICATION MEMBER FUNCTIONS
+      void start();
+      void end();
+      void advance();
+      void move_back();
+      void add(const Item& entry);
+      void remove_current();
+      ring_sequence& operator=(const ring_sequence& source);
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      bool is_item() const;
+      Item current() const;
+
+   private:
+      Item inline_items[N];
+      Item* items;         // inline_items, or the heap array once spilled
+      size_type capacity;  // number of slots in items
+      size_type head;
+      size_type used;
+      size_type current_index;
+      // HELPERS
+      size_type slot(size_type index) const;
+      void copy_from(const ring_sequence& source, Item* target) const;
+      void grow(size_type new_capacity);
+      bool spilled() const;
+   };
+}
+
+#include "ring_sequence.template" // Must include implementation
+#endif
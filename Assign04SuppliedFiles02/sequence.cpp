@@ -0,0 +1,18 @@
+// FILE: sequence.cpp
+// INSTANTIATIONS PROVIDED: sequence<double>, sequence<int>,
+//                          sequence<char> and sequence<record> (see
+//                          sequence.h for documentation; the
+//                          implementation is in sequence.template)
+// The member functions of these item types are compiled here once, and
+// sequence.h declares them extern so that programs using the sequence
+// link with sequence.o instead of compiling them again.
+
+#include "sequence.h"
+
+namespace CS3358_FA2021_A04
+{
+   template class sequence<double>;
+   template class sequence<int>;
+   template class sequence<char>;
+   template class sequence<record>;
+}
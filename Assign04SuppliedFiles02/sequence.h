@@ -1,15 +1,24 @@
 // FILE: sequence.h
-///////////////////////////////////////////////////////////////////////
-// NOTE: Two specialized versions of sequence (seqDouble for a sequence
-//       of real numbers and seqChar for a sequence of characters) are
-//       specified in this header file. For both versions, the same
-//       documentation applies; simply replace sequence in the
-//       documentation with seqDouble or seqChar as appropriate.
-///////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+// NOTE: sequence is a class template; the sequence of real numbers and
+//       the sequence of characters are sequence<double> and
+//       sequence<char>, both prebuilt in sequence.cpp (see PREBUILT
+//       INSTANTIATIONS below). The same documentation applies to all
+//       item types.
+//////////////////////////////////////////////////////////////////////
 // CLASS PROVIDED: sequence (a container class for a list of items,
 //                 where each list may have a designated item called
 //                 the current item)
 //
+// TEMPLATE PARAMETERS for the sequence class:
+//   class Item
+//     The type of the items in the sequence (see value_type below).
+//   size_t N (default 10)
+//     The number of items held inside the sequence object itself. A
+//     sequence of up to N items never allocates; adding the (N+1)st
+//     item moves all items to a heap array, which grows as needed.
+//     N must be positive.
+//
 // TYPEDEFS and MEMBER CONSTANTS for the sequence class:
 //   typedef ____ value_type
 //     sequence::value_type is the data type of the items in the sequence.
@@ -19,9 +28,14 @@
 //   typedef ____ size_type
 //     sequence::size_type is the data type of any variable that keeps
 //     track of how many items are in a sequence.
-//   static const size_type CAPACITY = _____
-//     sequence::CAPACITY is the maximum number of items that a
-//     sequence can hold.
+//   typedef ____ iterator
+//   typedef ____ const_iterator
+//     sequence::iterator and sequence::const_iterator are random-access
+//     iterators over the items of the sequence (in sequence order), so
+//     the sequence may be handed directly to standard algorithms.
+//   static const size_type CAPACITY = N
+//     sequence::CAPACITY is the number of items that a sequence can
+//     hold without allocating (more may be added; see add).
 //
 // CONSTRUCTOR for the sequence class:
 //   sequence()
@@ -49,12 +63,24 @@
 //           there is no longer any current item. Otherwise, the new current
 //           item is the item immediately before the original current item.
 //   void add(const value_type& entry)
-//     Pre:  size() < CAPACITY.
+//     Pre:  (none)
 //     Post: A new copy of entry has been inserted in the sequence after
 //           the current item. If there was no current item, then the new
 //           entry has been inserted as new first item of the sequence. In
 //           either case, the newly added item is now the current item of
 //           the sequence.
+//     Note: When size() was already CAPACITY (or the heap array was
+//           full), the items move to a heap array of twice the size, so
+//           iterators and data() pointers from before the add are no
+//           longer valid.
+//   void add(value_type&& entry)
+//     Pre:  (none)
+//     Post: Same as add(const value_type&), except that entry has been
+//           moved (not copied) into the sequence, so entry is left in a
+//           valid but unspecified state.
+//   template<class... Args> void emplace(Args&&... args)
+//     Pre:  value_type can be constructed from args.
+//     Post: Same as add, with the new item constructed from args.
 //   void remove_current()
 //     Pre:  is_item() returns true.
 //     Post: The current item has been removed from the sequence, and
@@ -75,45 +101,159 @@
 //   value_type current() const
 //     Pre:  is_item() returns true.
 //     Post: The item returned is the current item in the sequence.
+//   const value_type& current_ref() const
+//     Pre:  is_item() returns true.
+//     Post: The return value refers to the current item (no copy is
+//           made). It is valid until the next add or remove_current.
+//
+// SEARCH MEMBER FUNCTIONS for the sequence class:
+//   (For sequence<char> these scan the array with memchr, which the C
+//    library vectorizes, rather than comparing one item at a time.)
+//   bool find(const value_type& target)
+//     Pre:  (none)
+//     Post: If target occurs at or after the current item, the first
+//           such occurrence becomes the current item and true is
+//           returned. Otherwise there is no current item and false is
+//           returned. (Use start() first to search the whole sequence;
+//           advance() past a match before searching for the next one.)
+//   bool find_any(const value_type* set, size_type set_size)
+//     Pre:  set points to an array of set_size items.
+//     Post: Same as find, but the search is for the first item equal to
+//           any of set[0] through set[set_size-1].
+//   size_type count(const value_type& target) const
+//     Pre:  (none)
+//     Post: The return value is the number of items equal to target.
+//
+// ITERATOR and DIRECT-ACCESS MEMBER FUNCTIONS for the sequence class:
+//   (end() is already the cursor-positioning function, so the iterator
+//    range is named items_begin()/items_end(); cbegin()/cend() give the
+//    same range read-only.)
+//   iterator items_begin()
+//   const_iterator items_begin() const
+//   const_iterator cbegin() const
+//     Pre:  (none)
+//     Post: The return value refers to the first item of the sequence.
+//   iterator items_end()
+//   const_iterator items_end() const
+//   const_iterator cend() const
+//     Pre:  (none)
+//     Post: The return value refers to one past the last item.
+//   Item* data()
+//   const Item* data() const
+//     Pre:  (none)
+//     Post: The return value points to the contiguous array holding the
+//           items; [data(), data() + size()) is a valid range.
+//     Note: Reordering items through these leaves the current index
+//           (not the current item) unchanged.
 // VALUE SEMANTICS for the sequence class:
 //    Assignments and the copy constructor may be used with sequence
-//    objects.
+//    objects. A copy (made by either) keeps its items in the inline
+//    storage when they fit in it; an assignment then frees any heap
+//    array the target had. If an assignment has to allocate and the
+//    allocation fails, the target is left unchanged.
+//
+// PREBUILT INSTANTIATIONS:
+//   sequence<double>, sequence<int>, sequence<char> and sequence<record>
+//   (all with the default N) are compiled once, in sequence.cpp, and
+//   declared extern below; a program using any of them must link with
+//   sequence.o. The small member functions are inline, so they are
+//   still expanded in the caller. Other item types and other values of
+//   N are instantiated in the using translation unit as usual.
+//
+// STRUCT PROVIDED: record (a small plain-data item type)
+//   int key
+//   double value
+//   bool operator==(const record& a, const record& b)
+//     Post: Returns true if a and b have equal keys and equal values.
 
 #ifndef SEQUENCE_H
 #define SEQUENCE_H
 
-#include <cstdlib>  // provides size_t
+#include <cstdlib>      // provides size_t
+#include <type_traits>  // provides std::is_trivially_copyable
 
 namespace CS3358_FA2021_A04
 {
-   template<class Item>
+   template<class Item, size_t N = 10>
    class sequence
    {
+      static_assert(N > 0, "sequence needs room for at least one inline item");
+
    public:
       // TYPEDEFS and MEMBER CONSTANTS
       typedef Item value_type;
       typedef size_t size_type;
-      static const size_type CAPACITY = 10;
-      // CONSTRUCTOR
+      typedef Item* iterator;
+      typedef const Item* const_iterator;
+      static const size_type CAPACITY = N;
+      // CONSTRUCTORS and DESTRUCTOR
       sequence();
+      sequence(const sequence& source);
+      ~sequence();
       // MODIFICATION MEMBER FUNCTIONS
       void start();
       void end();
       void advance();
       void move_back();
       void add(const Item& entry);
+      void add(Item&& entry);
+      template<class... Args>
+      void emplace(Args&&... args);
       void remove_current();
+      sequence& operator=(const sequence& source);
       // CONSTANT MEMBER FUNCTIONS
       size_type size() const;
       bool is_item() const;
       Item current() const;
+      const Item& current_ref() const;
+      // SEARCH MEMBER FUNCTIONS
+      bool find(const Item& target);
+      bool find_any(const Item* set, size_type set_size);
+      size_type count(const Item& target) const;
+      // ITERATOR and DIRECT-ACCESS MEMBER FUNCTIONS
+      iterator items_begin();
+      const_iterator items_begin() const;
+      const_iterator cbegin() const;
+      iterator items_end();
+      const_iterator items_end() const;
+      const_iterator cend() const;
+      Item* data();
+      const Item* data() const;
 
    private:
-      Item data[CAPACITY];
+      Item inline_items[N];
+      Item* items;         // inline_items, or the heap array once spilled
+      size_type capacity;  // number of slots in items
       size_type used;
       size_type current_index;
+      // HELPERS (the tag argument is std::is_trivially_copyable<Item>)
+      void shift_up(size_type pos, std::true_type);
+      void shift_up(size_type pos, std::false_type);
+      void shift_down(size_type pos, std::true_type);
+      void shift_down(size_type pos, std::false_type);
+      Item& make_room();
+      void grow(size_type new_capacity);
+      bool owns(const Item* p) const;
+      bool spilled() const;
+   };
+
+   struct record
+   {
+      int key;
+      double value;
    };
+
+   inline bool operator==(const record& a, const record& b)
+   { return a.key == b.key && a.value == b.value; }
 }
 
 #include "sequence.template" // Must include implementation
-#endif
\ No newline at end of file
+
+namespace CS3358_FA2021_A04
+{
+   extern template class sequence<double>;
+   extern template class sequence<int>;
+   extern template class sequence<char>;
+   extern template class sequence<record>;
+}
+#endif
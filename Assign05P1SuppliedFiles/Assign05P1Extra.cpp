@@ -0,0 +1,537 @@
+#include "llcpInt.h"
+#include "ullcpInt.h"
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+using namespace std;
+
+void SeedRand();
+int  BoundedRandomInt(int lowerBound, int upperBound);
+bool Contains(Node* head, int target);
+bool SameList(Node* head, Node* model);
+bool SameList(UNode* head, Node* model);
+void ShowCase(const char what[], int whichCase, Node* model);
+bool TestNodePool(int testCasesToDo);
+bool TestListHandle(int testCasesToDo);
+bool TestUnrolledList(int testCasesToDo);
+bool TestComputeStats(int testCasesToDo);
+bool TestInsertSortedUpBatch(int testCasesToDo);
+bool TestSkipList(int testCasesToDo);
+
+// Each test below applies random operations to the structure under test
+// and, for comparison, the same operations to a plain Node* list built
+// with the original functions (the model), and checks that the two
+// agree after every case.
+const int LO_SIZE = 0,
+          HI_SIZE = 40,
+          LO_VALUE = 0,
+          HI_VALUE = 9;
+
+int main()
+{
+   // SeedRand(); // disabled for reproducible result
+
+   cout << "================================" << endl;
+   if ( !TestNodePool(20000) ||
+        !TestListHandle(20000) ||
+        !TestUnrolledList(20000) ||
+        !TestComputeStats(20000) ||
+        !TestInsertSortedUpBatch(20000) ||
+        !TestSkipList(2000) )
+      exit(EXIT_FAILURE);
+   cout << "================================" << endl;
+   cout << "test program terminated normally" << endl;
+   cout << "================================" << endl;
+
+   return EXIT_SUCCESS;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Function to test the NodePool functions
+// POST: Random lists have been built and edited through a pool and
+//       checked against the model, along with the pool's counts; the
+//       return value is true if every check passed.
+/////////////////////////////////////////////////////////////////////
+bool TestNodePool(int testCasesToDo)
+{
+   const int NODES_PER_CHUNK = 8;
+   NodePool pool;
+   Node *head = 0,
+        *model = 0;
+   long mostLive = 0;
+
+   PoolInit(pool, NODES_PER_CHUNK);
+   for (int testCasesDone = 1; testCasesDone <= testCasesToDo; ++testCasesDone)
+   {
+      int numOps = BoundedRandomInt(LO_SIZE, HI_SIZE);
+      for (int opCount = 0; opCount < numOps; ++opCount)
+      {
+         int value = BoundedRandomInt(LO_VALUE, HI_VALUE);
+         switch (BoundedRandomInt(0, 5))
+         {
+         case 0:
+            InsertAsHead(head, value, &pool);
+            InsertAsHead(model, value);
+            break;
+         case 1:
+            InsertAsTail(head, value, &pool);
+            InsertAsTail(model, value);
+            break;
+         case 2:
+            if (IsSortedUp(model))
+            {
+               InsertSortedUp(head, value, &pool);
+               InsertSortedUp(model, value);
+            }
+            break;
+         case 3:
+            if (Contains(model, value))
+            {
+               DelFirstTargetNode(head, value, &pool);
+               DelFirstTargetNode(model, value);
+            }
+            break;
+         case 4:
+            DelNodeBefore1stMatch(head, value, &pool);
+            DelNodeBefore1stMatch(model, value);
+            break;
+         default:
+            PromoteTarget(head, value, &pool);
+            PromoteTarget(model, value);
+         }
+      }
+
+      NodePoolStats stats = PoolStats(pool);
+      if (stats.live > mostLive) mostLive = stats.live;
+      if ( !SameList(head, model) ||
+           stats.live != FindListLength(model) ||
+           stats.reserved >= mostLive + NODES_PER_CHUNK )
+      {
+         ShowCase("NodePool", testCasesDone, model);
+         cout << "outcome: ";
+         ShowAll(cout, head);
+         cout << "live nodes: " << stats.live
+              << ", reserved nodes: " << stats.reserved << endl;
+         return false;
+      }
+      ListClear(head, 1, &pool);
+      ListClear(model, 1);
+   }
+
+   NodePoolStats stats = PoolStats(pool);
+   PoolRelease(pool);
+   if (stats.live != 0 || stats.allocations != stats.frees ||
+       PoolStats(pool).chunks != 0)
+   {
+      cout << "NodePool counts wrong after all lists cleared" << endl;
+      return false;
+   }
+   cout << "passed NodePool tests" << endl;
+   return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Function to test the List handle overloads
+// POST: Random operations have been applied to a List (with and
+//       without a pool) and checked against the model, including its
+//       tail and length; the return value is true if every check
+//       passed.
+/////////////////////////////////////////////////////////////////////
+bool TestListHandle(int testCasesToDo)
+{
+   NodePool pool;
+   List list;
+   Node *model = 0;
+
+   PoolInit(pool);
+   for (int testCasesDone = 1; testCasesDone <= testCasesToDo; ++testCasesDone)
+   {
+      ListInit(list, (testCasesDone % 2 == 0) ? &pool : 0);
+      int numOps = BoundedRandomInt(LO_SIZE, HI_SIZE);
+      for (int opCount = 0; opCount < numOps; ++opCount)
+      {
+         int value = BoundedRandomInt(LO_VALUE, HI_VALUE);
+         switch (BoundedRandomInt(0, 5))
+         {
+         case 0:
+            InsertAsHead(list, value);
+            InsertAsHead(model, value);
+            break;
+         case 1:
+            InsertAsTail(list, value);
+            InsertAsTail(model, value);
+            break;
+         case 2:
+            if (IsSortedUp(model))
+            {
+               InsertSortedUp(list, value);
+               InsertSortedUp(model, value);
+            }
+            break;
+         case 3:
+            if (Contains(model, value))
+            {
+               DelFirstTargetNode(list, value);
+               DelFirstTargetNode(model, value);
+            }
+            break;
+         case 4:
+            DelNodeBefore1stMatch(list, value);
+            DelNodeBefore1stMatch(model, value);
+            break;
+         default:
+            PromoteTarget(list, value);
+            PromoteTarget(model, value);
+         }
+      }
+
+      Node *last = model;
+      while (last != 0 && last->link != 0) last = last->link;
+      bool ok = (SameList(list.head, model) &&
+                 FindListLength(list) == FindListLength(model) &&
+                 IsSortedUp(list) == IsSortedUp(model) &&
+                 (list.tail == 0) == (last == 0) &&
+                 (last == 0 || (list.tail->data == last->data &&
+                                list.tail->link == 0)));
+      if (ok && model != 0)
+      {
+         int minValue, maxValue, listMin, listMax;
+         FindMinMax(model, minValue, maxValue);
+         FindMinMax(list, listMin, listMax);
+         ok = (listMin == minValue && listMax == maxValue &&
+               FindAverage(list) == FindAverage(model));
+      }
+      if (!ok)
+      {
+         ShowCase("List", testCasesDone, model);
+         cout << "outcome: ";
+         ShowAll(cout, list);
+         cout << "length: " << list.length << ", tail: "
+              << (list.tail ? list.tail->data : -1) << endl;
+         return false;
+      }
+      ListClear(list, 1);
+      ListClear(model, 1);
+   }
+   if (PoolStats(pool).live != 0)
+   {
+      cout << "List nodes not all returned to the pool" << endl;
+      return false;
+   }
+   PoolRelease(pool);
+   cout << "passed List tests" << endl;
+   return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Function to test the unrolled (UNode) list functions
+// POST: Random operations have been applied to unrolled lists long
+//       enough to span several UNodes and checked against the model;
+//       the return value is true if every check passed.
+/////////////////////////////////////////////////////////////////////
+bool TestUnrolledList(int testCasesToDo)
+{
+   UNode *head = 0;
+   Node *model = 0;
+
+   for (int testCasesDone = 1; testCasesDone <= testCasesToDo; ++testCasesDone)
+   {
+      int numOps = BoundedRandomInt(LO_SIZE, 3 * HI_SIZE);
+      for (int opCount = 0; opCount < numOps; ++opCount)
+      {
+         int value = BoundedRandomInt(LO_VALUE, HI_VALUE);
+         switch (BoundedRandomInt(0, 3))
+         {
+         case 0:
+            InsertAsHead(head, value);
+            InsertAsHead(model, value);
+            break;
+         case 1:
+            InsertAsTail(head, value);
+            InsertAsTail(model, value);
+            break;
+         case 2:
+            if (IsSortedUp(model))
+            {
+               InsertSortedUp(head, value);
+               InsertSortedUp(model, value);
+            }
+            break;
+         default:
+            if (Contains(model, value))
+            {
+               DelFirstTargetNode(head, value);
+               DelFirstTargetNode(model, value);
+            }
+         }
+      }
+
+      bool ok = (SameList(head, model) &&
+                 FindListLength(head) == FindListLength(model) &&
+                 IsSortedUp(head) == IsSortedUp(model));
+      if (ok && model != 0)
+      {
+         int minValue, maxValue, uMin, uMax;
+         FindMinMax(model, minValue, maxValue);
+         FindMinMax(head, uMin, uMax);
+         ok = (uMin == minValue && uMax == maxValue &&
+               FindAverage(head) == FindAverage(model));
+      }
+      if (!ok)
+      {
+         ShowCase("UNode", testCasesDone, model);
+         cout << "outcome: ";
+         ShowAll(cout, head);
+         return false;
+      }
+      ListClear(head, 1);
+      ListClear(model, 1);
+   }
+   cout << "passed UNode tests" << endl;
+   return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Function to test ComputeStats
+// POST: ComputeStats has been checked against FindListLength,
+//       FindMinMax, FindAverage and IsSortedUp on random lists; the
+//       return value is true if every check passed.
+/////////////////////////////////////////////////////////////////////
+bool TestComputeStats(int testCasesToDo)
+{
+   Node *model = 0;
+
+   for (int testCasesDone = 1; testCasesDone <= testCasesToDo; ++testCasesDone)
+   {
+      int numInts = BoundedRandomInt(LO_SIZE, HI_SIZE),
+          firstUnsorted = -1,
+          prevValue = 0;
+      for (int intCount = 0; intCount < numInts; ++intCount)
+      {
+         // mostly rising, so some lists come out sorted up
+         int newInt = (BoundedRandomInt(0, 3) == 0)
+                      ? BoundedRandomInt(LO_VALUE, HI_VALUE)
+                      : prevValue + BoundedRandomInt(0, 2);
+         if (intCount > 0 && newInt < prevValue && firstUnsorted == -1)
+            firstUnsorted = intCount;
+         InsertAsTail(model, newInt);
+         prevValue = newInt;
+      }
+
+      ListStats stats = ComputeStats(model);
+      bool ok = (stats.count == FindListLength(model) &&
+                 stats.sortedUp == IsSortedUp(model) &&
+                 stats.firstUnsorted == firstUnsorted);
+      if (ok && model != 0)
+      {
+         int minValue, maxValue;
+         FindMinMax(model, minValue, maxValue);
+         ok = (stats.minValue == minValue && stats.maxValue == maxValue &&
+               stats.mean == FindAverage(model) &&
+               stats.sum == (long long)(stats.mean * stats.count + 0.5));
+      }
+      else if (ok)
+         ok = (stats.sum == 0 && stats.mean == 0.0 &&
+               stats.minValue == 0 && stats.maxValue == 0);
+      if (!ok)
+      {
+         ShowCase("ComputeStats", testCasesDone, model);
+         cout << "count " << stats.count << ", sum " << stats.sum
+              << ", min " << stats.minValue << ", max " << stats.maxValue
+              << ", mean " << stats.mean << ", sortedUp " << stats.sortedUp
+              << ", firstUnsorted " << stats.firstUnsorted << endl;
+         return false;
+      }
+      ListClear(model, 1);
+   }
+   cout << "passed ComputeStats tests" << endl;
+   return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Function to test InsertSortedUpBatch
+// POST: Random batches have been inserted into random sorted up lists
+//       and checked against inserting them one at a time; the return
+//       value is true if every check passed.
+/////////////////////////////////////////////////////////////////////
+bool TestInsertSortedUpBatch(int testCasesToDo)
+{
+   NodePool pool;
+   Node *head = 0,
+        *model = 0;
+   int batch[HI_SIZE];
+
+   PoolInit(pool);
+   for (int testCasesDone = 1; testCasesDone <= testCasesToDo; ++testCasesDone)
+   {
+      int numInts = BoundedRandomInt(LO_SIZE, HI_SIZE),
+          batchSize = BoundedRandomInt(LO_SIZE, HI_SIZE);
+      for (int intCount = 0; intCount < numInts; ++intCount)
+      {
+         int newInt = BoundedRandomInt(LO_VALUE, HI_VALUE);
+         InsertSortedUp(head, newInt, &pool);
+         InsertSortedUp(model, newInt);
+      }
+      for (int intCount = 0; intCount < batchSize; ++intCount)
+      {
+         batch[intCount] = BoundedRandomInt(LO_VALUE - 2, HI_VALUE + 2);
+         InsertSortedUp(model, batch[intCount]);
+      }
+      InsertSortedUpBatch(head, batch, batchSize, &pool);
+
+      if ( !SameList(head, model) ||
+           PoolStats(pool).live != numInts + batchSize )
+      {
+         ShowCase("InsertSortedUpBatch", testCasesDone, model);
+         cout << "outcome: ";
+         ShowAll(cout, head);
+         return false;
+      }
+      ListClear(head, 1, &pool);
+      ListClear(model, 1);
+   }
+   PoolRelease(pool);
+   cout << "passed InsertSortedUpBatch tests" << endl;
+   return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Function to test the SkipList functions
+// POST: Random inserts, deletes and searches have been applied to
+//       skip lists long enough to use several index levels, and the
+//       chain checked against the model; the return value is true if
+//       every check passed.
+/////////////////////////////////////////////////////////////////////
+bool TestSkipList(int testCasesToDo)
+{
+   const int SKIP_HI_VALUE = 200;
+   NodePool pool;
+   SkipList list;
+   Node *model = 0;
+
+   PoolInit(pool);
+   for (int testCasesDone = 1; testCasesDone <= testCasesToDo; ++testCasesDone)
+   {
+      SkipListInit(list, (testCasesDone % 2 == 0) ? &pool : 0);
+      int numOps = BoundedRandomInt(LO_SIZE, 20 * HI_SIZE);
+      bool ok = true;
+      for (int opCount = 0; ok && opCount < numOps; ++opCount)
+      {
+         int value = BoundedRandomInt(LO_VALUE, SKIP_HI_VALUE);
+         switch (BoundedRandomInt(0, 3))
+         {
+         case 0:
+         case 1:
+            InsertSortedUp(list, value);
+            InsertSortedUp(model, value);
+            break;
+         case 2:
+            if (Contains(model, value))
+            {
+               ok = DelFirstTargetNode(list, value);
+               DelFirstTargetNode(model, value);
+            }
+            break;
+         default:
+            ok = (SkipListContains(list, value) == Contains(model, value));
+         }
+      }
+
+      ok = ok && SameList(list.head, model) &&
+           FindListLength(list) == FindListLength(model) &&
+           list.height >= 0 && list.height <= SKIP_MAX_LEVELS;
+      if (ok && testCasesDone % 3 == 0)
+      {
+         // hand the chain over and clear it as a plain list
+         Node *chain = SkipListRelease(list);
+         ok = (list.head == 0 && SameList(chain, model));
+         ListClear(chain, 1, list.pool);
+      }
+      if (!ok)
+      {
+         ShowCase("SkipList", testCasesDone, model);
+         cout << "outcome: ";
+         ShowAll(cout, list.head);
+         return false;
+      }
+      ListClear(list, 1);
+      ListClear(model, 1);
+   }
+   if (PoolStats(pool).live != 0)
+   {
+      cout << "SkipList nodes not all returned to the pool" << endl;
+      return false;
+   }
+   PoolRelease(pool);
+   cout << "passed SkipList tests" << endl;
+   return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Function to seed the random number generator
+// PRE:  none
+// POST: The random number generator has been seeded.
+/////////////////////////////////////////////////////////////////////
+void SeedRand()
+{
+   srand( (unsigned) time(NULL) );
+}
+
+/////////////////////////////////////////////////////////////////////
+// Function to generate a random integer between
+// lowerBound and upperBound (inclusive)
+// PRE:  upperBound is not less than lowerBound
+//       The random number generator has been seeded.
+// POST: A random integer between lowerBound and upperBound
+//       has been returned.
+/////////////////////////////////////////////////////////////////////
+int BoundedRandomInt(int lowerBound, int upperBound)
+{
+   return ( rand() % (upperBound - lowerBound + 1) ) + lowerBound;
+}
+
+bool Contains(Node* head, int target)
+{
+   while (head != 0 && head->data != target)
+      head = head->link;
+   return head != 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Functions to check a list against the model
+// POST: returns true if the list holds the same values as model, in
+//       the same order (and, for an unrolled list, has no empty
+//       UNode); otherwise returns false
+/////////////////////////////////////////////////////////////////////
+bool SameList(Node* head, Node* model)
+{
+   while (head != 0 && model != 0)
+   {
+      if (head->data != model->data) return false;
+      head = head->link;
+      model = model->link;
+   }
+   return head == 0 && model == 0;
+}
+
+bool SameList(UNode* head, Node* model)
+{
+   while (head != 0)
+   {
+      if (head->count < 1 || head->count > UNODE_CAPACITY) return false;
+      for (int i = 0; i < head->count; ++i)
+      {
+         if (model == 0 || head->data[i] != model->data) return false;
+         model = model->link;
+      }
+      head = head->link;
+   }
+   return model == 0;
+}
+
+void ShowCase(const char what[], int whichCase, Node* model)
+{
+   cout << what << " contents error in test case " << whichCase << endl;
+   cout << "ought2b: ";
+   ShowAll(cout, model);
+}
@@ -3,11 +3,97 @@
 //
 // CS3358 - Koh
 
+#include <algorithm>   // provides std::sort
 #include <iostream>
 #include <cstdlib>
+#include <vector>      // provides std::vector
 #include "llcpInt.h"
 using namespace std;
 
+namespace
+{
+   // Gets a node from pool (or from new, with no pool) and fills it in
+   inline Node* NewNode(NodePool* pool, int value, Node* link)
+   {
+      Node *newNodePtr = pool ? PoolNew(*pool) : new Node;
+      newNodePtr->data = value;
+      newNodePtr->link = link;
+      return newNodePtr;
+   }
+
+   // Gives a node back to pool (or to delete, with no pool)
+   inline void FreeNode(NodePool* pool, Node* nodePtr)
+   {
+      if (pool)
+         PoolDelete(*pool, nodePtr);
+      else
+         delete nodePtr;
+   }
+}
+
+void PoolInit(NodePool& pool, int nodesPerChunk)
+{
+   pool.chunkList = pool.nextFree = pool.chunkEnd = pool.freeList = 0;
+   // Room for the chunk-linking node plus at least one usable node
+   pool.nodesPerChunk = (nodesPerChunk < 2) ? 2 : nodesPerChunk;
+   pool.allocations = pool.frees = pool.chunks = 0;
+}
+
+Node* PoolNew(NodePool& pool)
+{
+   Node *nodePtr;
+
+   if (pool.freeList != 0)
+   {
+      nodePtr = pool.freeList;
+      pool.freeList = nodePtr->link;
+   }
+   else
+   {
+      if (pool.nextFree == pool.chunkEnd)
+      {
+         Node *chunk = new Node[pool.nodesPerChunk];
+         chunk->link = pool.chunkList;
+         pool.chunkList = chunk;
+         pool.nextFree = chunk + 1;
+         pool.chunkEnd = chunk + pool.nodesPerChunk;
+         ++pool.chunks;
+      }
+      nodePtr = pool.nextFree++;
+   }
+   ++pool.allocations;
+   return nodePtr;
+}
+
+void PoolDelete(NodePool& pool, Node* nodePtr)
+{
+   nodePtr->link = pool.freeList;
+   pool.freeList = nodePtr;
+   ++pool.frees;
+}
+
+void PoolRelease(NodePool& pool)
+{
+   while (pool.chunkList != 0)
+   {
+      Node *chunk = pool.chunkList;
+      pool.chunkList = chunk->link;
+      delete [] chunk;
+   }
+   PoolInit(pool, pool.nodesPerChunk);
+}
+
+NodePoolStats PoolStats(const NodePool& pool)
+{
+   NodePoolStats stats;
+   stats.allocations = pool.allocations;
+   stats.frees = pool.frees;
+   stats.live = pool.allocations - pool.frees;
+   stats.chunks = pool.chunks;
+   stats.reserved = pool.chunks * (pool.nodesPerChunk - 1);
+   return stats;
+}
+
 int FindListLength(Node* headPtr)
 {
    int length = 0;
@@ -34,19 +120,14 @@ bool IsSortedUp(Node* headPtr)
    return true;
 }
 
-void InsertAsHead(Node*& headPtr, int value)
+void InsertAsHead(Node*& headPtr, int value, NodePool* pool)
 {
-   Node *newNodePtr = new Node;
-   newNodePtr->data = value;
-   newNodePtr->link = headPtr;
-   headPtr = newNodePtr;
+   headPtr = NewNode(pool, value, headPtr);
 }
 
-void InsertAsTail(Node*& headPtr, int value)
+void InsertAsTail(Node*& headPtr, int value, NodePool* pool)
 {
-   Node *newNodePtr = new Node;
-   newNodePtr->data = value;
-   newNodePtr->link = 0;
+   Node *newNodePtr = NewNode(pool, value, 0);
    if (headPtr == 0)
       headPtr = newNodePtr;
    else
@@ -59,7 +140,7 @@ void InsertAsTail(Node*& headPtr, int value)
    }
 }
 
-void InsertSortedUp(Node*& headPtr, int value)
+void InsertSortedUp(Node*& headPtr, int value, NodePool* pool)
 {
    Node *precursor = 0,
         *cursor = headPtr;
@@ -70,9 +151,7 @@ void InsertSortedUp(Node*& headPtr, int value)
       cursor = cursor->link;
    }
 
-   Node *newNodePtr = new Node;
-   newNodePtr->data = value;
-   newNodePtr->link = cursor;
+   Node *newNodePtr = NewNode(pool, value, cursor);
    if (cursor == headPtr)
       headPtr = newNodePtr;
    else
@@ -129,7 +208,30 @@ void InsertSortedUp(Node*& headPtr, int value)
    ///////////////////////////////////////////////////////////
 }
 
-bool DelFirstTargetNode(Node*& headPtr, int target)
+// Inserts values[0] through values[k-1] into the (sorted up) list, with
+// the same result as k InsertSortedUp calls: the batch is sorted once
+// and then merged into the list in a single pass, so the cost is
+// O(n + k log k) instead of O(k n). With a pool, the new nodes come
+// from its contiguous chunks.
+void InsertSortedUpBatch(Node*& headPtr, const int* values, size_t k,
+                         NodePool* pool)
+{
+   std::vector<int> batch(values, values + k);
+   std::sort(batch.begin(), batch.end());
+
+   // link is the link the next new node may go into; like
+   // InsertSortedUp, a new node goes in front of any equal nodes
+   Node **link = &headPtr;
+   for (size_t i = 0; i < k; ++i)
+   {
+      while (*link != 0 && (*link)->data < batch[i])
+         link = &(*link)->link;
+      *link = NewNode(pool, batch[i], *link);
+      link = &(*link)->link;
+   }
+}
+
+bool DelFirstTargetNode(Node*& headPtr, int target, NodePool* pool)
 {
    Node *precursor = 0,
         *cursor = headPtr;
@@ -148,11 +250,11 @@ bool DelFirstTargetNode(Node*& headPtr, int target)
       headPtr = headPtr->link;
    else
       precursor->link = cursor->link;
-   delete cursor;
+   FreeNode(pool, cursor);
    return true;
 }
 
-bool DelNodeBefore1stMatch(Node*& headPtr, int target)
+bool DelNodeBefore1stMatch(Node*& headPtr, int target, NodePool* pool)
 {
    if (headPtr == 0 || headPtr->link == 0 || headPtr->data == target) return false;
    Node *cur = headPtr->link, *pre = headPtr, *prepre = 0;
@@ -166,12 +268,12 @@ bool DelNodeBefore1stMatch(Node*& headPtr, int target)
    if (cur == headPtr->link)
    {
       headPtr = cur;
-      delete pre;
+      FreeNode(pool, pre);
    }
    else
    {
       prepre->link = cur;
-      delete pre;
+      FreeNode(pool, pre);
    }
    return true;
 }
@@ -231,7 +333,56 @@ double FindAverage(Node* headPtr)
    }
 }
 
-void ListClear(Node*& headPtr, int noMsg)
+ListStats ComputeStats(Node* headPtr)
+{
+   ListStats stats;
+   stats.count = 0;
+   stats.sum = 0;
+   stats.minValue = stats.maxValue = 0;
+   stats.mean = 0.0;
+   stats.sortedUp = true;
+   stats.firstUnsorted = -1;
+   if (headPtr == 0)
+      return stats;
+
+   int low = headPtr->data,
+       high = headPtr->data,
+       previous = headPtr->data,
+       count = 0,
+       firstUnsorted = -1;
+   long long sum = 0;
+
+   while (headPtr != 0)
+   {
+      Node *next = headPtr->link;
+#if defined(__GNUC__)
+      // Start fetching the node after next while this one is processed
+      // (next itself is already on its way, as the loop needs it)
+      if (next != 0)
+         __builtin_prefetch(next->link);
+#endif
+      int value = headPtr->data;
+      sum += value;
+      low = (value < low) ? value : low;
+      high = (value > high) ? value : high;
+      if (value < previous && firstUnsorted < 0)
+         firstUnsorted = count;
+      previous = value;
+      ++count;
+      headPtr = next;
+   }
+
+   stats.count = count;
+   stats.sum = sum;
+   stats.minValue = low;
+   stats.maxValue = high;
+   stats.mean = double(sum) / count;
+   stats.sortedUp = (firstUnsorted < 0);
+   stats.firstUnsorted = firstUnsorted;
+   return stats;
+}
+
+void ListClear(Node*& headPtr, int noMsg, NodePool* pool)
 {
    int count = 0;
 
@@ -239,7 +390,7 @@ void ListClear(Node*& headPtr, int noMsg)
    while (headPtr != 0)
    {
       headPtr = headPtr->link;
-      delete cursor;
+      FreeNode(pool, cursor);
       cursor = headPtr;
       ++count;
    }
@@ -249,7 +400,7 @@ void ListClear(Node*& headPtr, int noMsg)
 }
 
 // Definition of PromoteTarget
-void PromoteTarget(Node*& headPtr, int target)
+void PromoteTarget(Node*& headPtr, int target, NodePool* pool)
 {
    Node *cursor = headPtr;
    Node *prev = 0;
@@ -271,18 +422,12 @@ void PromoteTarget(Node*& headPtr, int target)
    if (headPtr == 0)
    {
       // Case 1: If list is empty, add node with target
-      Node *newNodePtr = new Node;
-      newNodePtr->data = target;
-      newNodePtr->link = 0;
-      headPtr = newNodePtr;
+      headPtr = NewNode(pool, target, 0);
    }
    else if (targetCount < 1)
    {
       // Case 2: If target isn't found, append new node to end of list
-      Node *newNodePtr = new Node;
-      newNodePtr->data = target;
-      newNodePtr->link = 0;
-      prev->link = newNodePtr;
+      prev->link = NewNode(pool, target, 0);
    }
    else
    {
@@ -346,3 +491,280 @@ void PromoteTarget(Node*& headPtr, int target)
       } // End Case 3b
    } // End Case 3
 } // End PromoteTarget()
+
+void ListInit(List& list, NodePool* pool)
+{
+   list.head = list.tail = 0;
+   list.length = 0;
+   list.pool = pool;
+}
+
+int FindListLength(const List& list) { return list.length; }
+
+bool IsSortedUp(const List& list) { return IsSortedUp(list.head); }
+
+void InsertAsHead(List& list, int value)
+{
+   InsertAsHead(list.head, value, list.pool);
+   if (list.tail == 0)
+      list.tail = list.head;
+   ++list.length;
+}
+
+void InsertAsTail(List& list, int value)
+{
+   Node *newNodePtr = NewNode(list.pool, value, 0);
+   if (list.tail == 0)
+      list.head = newNodePtr;
+   else
+      list.tail->link = newNodePtr;
+   list.tail = newNodePtr;
+   ++list.length;
+}
+
+void InsertSortedUp(List& list, int value)
+{
+   // A value that belongs at the end (the common case when building a
+   // list in order) is appended without walking the list
+   if (list.tail == 0 || list.tail->data <= value)
+      InsertAsTail(list, value);
+   else
+   {
+      InsertSortedUp(list.head, value, list.pool);
+      ++list.length;
+   }
+}
+
+bool DelFirstTargetNode(List& list, int target)
+{
+   Node *precursor = 0,
+        *cursor = list.head;
+
+   while (cursor != 0 && cursor->data != target)
+   {
+      precursor = cursor;
+      cursor = cursor->link;
+   }
+   if (cursor == 0)
+   {
+      cout << target << " not found." << endl;
+      return false;
+   }
+   if (cursor == list.head)
+      list.head = list.head->link;
+   else
+      precursor->link = cursor->link;
+   if (cursor == list.tail)
+      list.tail = precursor;
+   FreeNode(list.pool, cursor);
+   --list.length;
+   return true;
+}
+
+bool DelNodeBefore1stMatch(List& list, int target)
+{
+   // The node deleted always has a node after it, so tail is unchanged
+   if ( ! DelNodeBefore1stMatch(list.head, target, list.pool) )
+      return false;
+   --list.length;
+   return true;
+}
+
+void ShowAll(ostream& outs, const List& list) { ShowAll(outs, list.head); }
+
+void FindMinMax(const List& list, int& minValue, int& maxValue)
+{
+   FindMinMax(list.head, minValue, maxValue);
+}
+
+double FindAverage(const List& list) { return FindAverage(list.head); }
+
+void ListClear(List& list, int noMsg)
+{
+   ListClear(list.head, noMsg, list.pool);
+   list.tail = 0;
+   list.length = 0;
+}
+
+void PromoteTarget(List& list, int target)
+{
+   // PromoteTarget may append a node or move the last node to the
+   // front; it walks the whole list anyway, so walking it once more to
+   // find the tail and length does not change its cost
+   PromoteTarget(list.head, target, list.pool);
+   list.tail = 0;
+   list.length = 0;
+   for (Node *cursor = list.head; cursor != 0; cursor = cursor->link)
+   {
+      list.tail = cursor;
+      ++list.length;
+   }
+}
+
+namespace
+{
+   // Finds where value belongs in list: the returned link is the one in
+   // front of the first chain node whose data is not less than value,
+   // and update[i] (if update is not 0) is the corresponding link on
+   // index level i. Each level is searched from the last entry passed
+   // on the level above.
+   Node** SkipSearch(const SkipList& list, int value, SkipIndex** update[])
+   {
+      SkipIndex *at = 0;   // last entry passed on the current level
+      Node *from = 0;      // last chain node known to be less than value
+
+      for (int i = list.height - 1; i >= 0; --i)
+      {
+         SkipIndex **link = (at == 0)
+                            ? const_cast<SkipIndex**>(&list.levels[i])
+                            : &at->right;
+         while (*link != 0 && (*link)->data < value)
+         {
+            at = *link;
+            link = &at->right;
+         }
+         if (update != 0)
+            update[i] = link;
+         if (at != 0)
+         {
+            from = at->node;
+            at = at->down;
+         }
+      }
+
+      Node **nodeLink = (from == 0) ? const_cast<Node**>(&list.head)
+                                    : &from->link;
+      while (*nodeLink != 0 && (*nodeLink)->data < value)
+         nodeLink = &(*nodeLink)->link;
+      return nodeLink;
+   }
+
+   // Returns how many index levels a new node gets entries on (0 for
+   // about 3 nodes in 4), from the list's own xorshift generator
+   int SkipRandomHeight(SkipList& list)
+   {
+      int height = 0;
+      unsigned bits;
+
+      do
+      {
+         list.seed ^= list.seed << 13;
+         list.seed ^= list.seed >> 17;
+         list.seed ^= list.seed << 5;
+         bits = list.seed;
+         while ((bits & 3) == 0 && height < SKIP_MAX_LEVELS)
+         {
+            ++height;
+            bits >>= 2;
+         }
+      } while (bits == 0 && height < SKIP_MAX_LEVELS);
+
+      return height;
+   }
+
+   void SkipIndexClear(SkipList& list)
+   {
+      for (int i = 0; i < list.height; ++i)
+      {
+         while (list.levels[i] != 0)
+         {
+            SkipIndex *entry = list.levels[i];
+            list.levels[i] = entry->right;
+            delete entry;
+         }
+      }
+      list.height = 0;
+   }
+}
+
+void SkipListInit(SkipList& list, NodePool* pool)
+{
+   list.head = 0;
+   for (int i = 0; i < SKIP_MAX_LEVELS; ++i)
+      list.levels[i] = 0;
+   list.height = 0;
+   list.length = 0;
+   list.seed = 2463534242u;
+   list.pool = pool;
+}
+
+int FindListLength(const SkipList& list) { return list.length; }
+
+void InsertSortedUp(SkipList& list, int value)
+{
+   SkipIndex **update[SKIP_MAX_LEVELS];
+   Node **nodeLink = SkipSearch(list, value, update);
+
+   Node *newNodePtr = NewNode(list.pool, value, *nodeLink);
+   *nodeLink = newNodePtr;
+   ++list.length;
+
+   int height = SkipRandomHeight(list);
+   for ( ; list.height < height; ++list.height)
+      update[list.height] = &list.levels[list.height];
+
+   SkipIndex *below = 0;
+   for (int i = 0; i < height; ++i)
+   {
+      SkipIndex *entry = new SkipIndex;
+      entry->data = value;
+      entry->node = newNodePtr;
+      entry->right = *update[i];
+      entry->down = below;
+      *update[i] = entry;
+      below = entry;
+   }
+}
+
+bool DelFirstTargetNode(SkipList& list, int target)
+{
+   SkipIndex **update[SKIP_MAX_LEVELS];
+   Node **nodeLink = SkipSearch(list, target, update);
+   Node *cursor = *nodeLink;
+
+   if (cursor == 0 || cursor->data != target)
+   {
+      cout << target << " not found." << endl;
+      return false;
+   }
+
+   // cursor is the first node with its value, so any entry for it is
+   // the first entry at or past target on its level
+   for (int i = 0; i < list.height; ++i)
+   {
+      SkipIndex *entry = *update[i];
+      if (entry == 0 || entry->node != cursor)
+         break;
+      *update[i] = entry->right;
+      delete entry;
+   }
+   while (list.height > 0 && list.levels[list.height - 1] == 0)
+      --list.height;
+
+   *nodeLink = cursor->link;
+   FreeNode(list.pool, cursor);
+   --list.length;
+   return true;
+}
+
+bool SkipListContains(const SkipList& list, int target)
+{
+   Node *found = *SkipSearch(list, target, 0);
+   return found != 0 && found->data == target;
+}
+
+Node* SkipListRelease(SkipList& list)
+{
+   Node *chain = list.head;
+   SkipIndexClear(list);
+   list.head = 0;
+   list.length = 0;
+   return chain;
+}
+
+void ListClear(SkipList& list, int noMsg)
+{
+   SkipIndexClear(list);
+   ListClear(list.head, noMsg, list.pool);
+   list.length = 0;
+}
@@ -1,6 +1,7 @@
 #ifndef LLCP_INT_H
 #define LLCP_INT_H
 
+#include <cstddef>   // provides size_t
 #include <iostream>
 
 struct Node
@@ -9,19 +10,145 @@ struct Node
    Node *link;
 };
 
+// A NodePool hands out Nodes from contiguous chunks (nodesPerChunk
+// Nodes each, the first of which links the chunks together) and keeps
+// freed Nodes on a free list (threaded through their links) for reuse.
+// The functions below that create or delete nodes take an optional pool;
+// with none (0) they use new and delete as before. A node must go back
+// to the pool it came from, so a list should use one pool throughout.
+// PoolRelease frees every chunk at once, without visiting the nodes;
+// afterwards every list built from the pool is gone and its head
+// pointer must be reset (or the list dropped) by the caller.
+struct NodePool
+{
+   Node *chunkList;    // chunks obtained so far
+   Node *nextFree;     // next never-used node in the newest chunk
+   Node *chunkEnd;     // one past the newest chunk's last node
+   Node *freeList;     // freed nodes, ready for reuse
+   int   nodesPerChunk;
+   long  allocations;
+   long  frees;
+   long  chunks;
+};
+
+struct NodePoolStats
+{
+   long allocations;   // nodes handed out (new or reused)
+   long frees;         // nodes given back
+   long live;          // allocations - frees
+   long chunks;        // chunks obtained from the heap
+   long reserved;      // nodes the chunks can hold
+};
+
+void   PoolInit(NodePool& pool, int nodesPerChunk = 256);
+Node*  PoolNew(NodePool& pool);
+void   PoolDelete(NodePool& pool, Node* nodePtr);
+void   PoolRelease(NodePool& pool);
+NodePoolStats PoolStats(const NodePool& pool);
+
 int    FindListLength(Node* headPtr);
 bool   IsSortedUp(Node* headPtr);
-void   InsertAsHead(Node*& headPtr, int value);
-void   InsertAsTail(Node*& headPtr, int value);
-void   InsertSortedUp(Node*& headPtr, int value);
-bool   DelFirstTargetNode(Node*& headPtr, int target);
-bool   DelNodeBefore1stMatch(Node*& headPtr, int target);
+void   InsertAsHead(Node*& headPtr, int value, NodePool* pool = 0);
+void   InsertAsTail(Node*& headPtr, int value, NodePool* pool = 0);
+void   InsertSortedUp(Node*& headPtr, int value, NodePool* pool = 0);
+void   InsertSortedUpBatch(Node*& headPtr, const int* values, size_t k,
+                           NodePool* pool = 0);
+bool   DelFirstTargetNode(Node*& headPtr, int target, NodePool* pool = 0);
+bool   DelNodeBefore1stMatch(Node*& headPtr, int target,
+                             NodePool* pool = 0);
 void   ShowAll(std::ostream& outs, Node* headPtr);
 void   FindMinMax(Node* headPtr, int& minValue, int& maxValue);
 double FindAverage(Node* headPtr);
-void   ListClear(Node*& headPtr, int noMsg = 0);
+void   ListClear(Node*& headPtr, int noMsg = 0, NodePool* pool = 0);
+
+// ComputeStats gathers in one traversal what FindListLength,
+// FindMinMax, FindAverage and IsSortedUp find in four. For an empty
+// list count is 0, mean is 0.0, minValue and maxValue are 0, and the
+// list counts as sorted. firstUnsorted is the position (counting from
+// 0) of the first node whose data is less than the data before it, or
+// -1 if the list is sorted up.
+struct ListStats
+{
+   int       count;
+   long long sum;
+   int       minValue;
+   int       maxValue;
+   double    mean;
+   bool      sortedUp;
+   int       firstUnsorted;
+};
+
+ListStats ComputeStats(Node* headPtr);
 
 // prototype of PromoteTarget
-void PromoteTarget(Node*& headPtr, int target);
+void PromoteTarget(Node*& headPtr, int target, NodePool* pool = 0);
+
+// A List is a handle on a Node chain that also tracks the last node and
+// the node count, so appending and asking for the length take O(1)
+// time. The overloads below keep tail and length up to date; the chain
+// itself is an ordinary one (head may be passed to the Node* functions
+// that only read the list). Nodes are obtained from (and returned to)
+// pool, or with new and delete when pool is 0.
+struct List
+{
+   Node     *head;
+   Node     *tail;
+   int       length;
+   NodePool *pool;
+};
+
+void   ListInit(List& list, NodePool* pool = 0);
+int    FindListLength(const List& list);
+bool   IsSortedUp(const List& list);
+void   InsertAsHead(List& list, int value);
+void   InsertAsTail(List& list, int value);
+void   InsertSortedUp(List& list, int value);
+bool   DelFirstTargetNode(List& list, int target);
+bool   DelNodeBefore1stMatch(List& list, int target);
+void   ShowAll(std::ostream& outs, const List& list);
+void   FindMinMax(const List& list, int& minValue, int& maxValue);
+double FindAverage(const List& list);
+void   ListClear(List& list, int noMsg = 0);
+void   PromoteTarget(List& list, int target);
+
+// A SkipList keeps a sorted up Node chain (head, the same kind of list
+// InsertSortedUp builds) plus levels of index entries over it, so that
+// inserting, deleting and searching take O(log n) expected time instead
+// of a walk from the head. Index level 0 has an entry for about 1 node
+// in 4, level 1 for about 1 in 16, and so on; levels[i] is the first
+// entry of index level i. Equal values are allowed; as with the Node*
+// functions, a new node goes in front of any equal nodes and
+// DelFirstTargetNode removes the first of them. The chain may be read
+// with the Node* functions (ShowAll(outs, list.head), ...) but must
+// only be changed through the SkipList functions. SkipListRelease
+// frees the index and hands the chain over as a plain Node* list.
+const int SKIP_MAX_LEVELS = 16;
+
+struct SkipIndex
+{
+   int        data;    // copy of node->data, so a search step reads
+                       //   only the entry
+   Node      *node;    // the chain node this entry stands for
+   SkipIndex *right;   // next entry on the same level
+   SkipIndex *down;    // entry for the same node one level lower (or 0)
+};
+
+struct SkipList
+{
+   Node      *head;
+   SkipIndex *levels[SKIP_MAX_LEVELS];
+   int        height;  // number of index levels in use
+   int        length;
+   unsigned   seed;    // state for choosing new entries' levels
+   NodePool  *pool;
+};
+
+void   SkipListInit(SkipList& list, NodePool* pool = 0);
+int    FindListLength(const SkipList& list);
+void   InsertSortedUp(SkipList& list, int value);
+bool   DelFirstTargetNode(SkipList& list, int target);
+bool   SkipListContains(const SkipList& list, int target);
+Node*  SkipListRelease(SkipList& list);
+void   ListClear(SkipList& list, int noMsg = 0);
 
 #endif
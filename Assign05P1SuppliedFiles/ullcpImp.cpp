@@ -0,0 +1,254 @@
+// Unrolled linked-list toolkit (see ullcpInt.h)
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>   // provides memcpy, memmove
+#include "ullcpInt.h"
+using namespace std;
+
+namespace
+{
+   // Returns a new node holding just value, linked to link
+   inline UNode* NewUNode(int value, UNode* link)
+   {
+      UNode *newNodePtr = new UNode;
+      newNodePtr->link = link;
+      newNodePtr->count = 1;
+      newNodePtr->data[0] = value;
+      return newNodePtr;
+   }
+
+   // Puts value at data[pos] of a node that is not full, moving the
+   // items from pos on up one place
+   inline void InsertAt(UNode* nodePtr, int pos, int value)
+   {
+      memmove(nodePtr->data + pos + 1, nodePtr->data + pos,
+              (nodePtr->count - pos) * sizeof(int));
+      nodePtr->data[pos] = value;
+      ++nodePtr->count;
+   }
+
+   // Moves the upper half of a full node's items into a new node that
+   // follows it
+   inline void SplitUNode(UNode* nodePtr)
+   {
+      int keep = nodePtr->count / 2;
+      UNode *upper = new UNode;
+      upper->count = nodePtr->count - keep;
+      memcpy(upper->data, nodePtr->data + keep, upper->count * sizeof(int));
+      upper->link = nodePtr->link;
+      nodePtr->link = upper;
+      nodePtr->count = keep;
+   }
+}
+
+int FindListLength(UNode* headPtr)
+{
+   int length = 0;
+
+   while (headPtr != 0)
+   {
+      length += headPtr->count;
+      headPtr = headPtr->link;
+   }
+
+   return length;
+}
+
+bool IsSortedUp(UNode* headPtr)
+{
+   int previous = 0;
+   bool first = true;
+
+   while (headPtr != 0)
+   {
+      if ( ! first && headPtr->data[0] < previous)
+         return false;
+      for (int i = 1; i < headPtr->count; ++i)
+         if (headPtr->data[i] < headPtr->data[i - 1])
+            return false;
+      previous = headPtr->data[headPtr->count - 1];
+      first = false;
+      headPtr = headPtr->link;
+   }
+   return true;
+}
+
+void InsertAsHead(UNode*& headPtr, int value)
+{
+   if (headPtr != 0 && headPtr->count < UNODE_CAPACITY)
+      InsertAt(headPtr, 0, value);
+   else
+      headPtr = NewUNode(value, headPtr);
+}
+
+void InsertAsTail(UNode*& headPtr, int value)
+{
+   if (headPtr == 0)
+   {
+      headPtr = NewUNode(value, 0);
+      return;
+   }
+
+   UNode *cursor = headPtr;
+   while (cursor->link != 0) // not at last node
+      cursor = cursor->link;
+   if (cursor->count < UNODE_CAPACITY)
+      cursor->data[cursor->count++] = value;
+   else
+      cursor->link = NewUNode(value, 0);
+}
+
+void InsertSortedUp(UNode*& headPtr, int value)
+{
+   if (headPtr == 0)
+   {
+      headPtr = NewUNode(value, 0);
+      return;
+   }
+
+   // The value goes into the first node whose last item is not less
+   // than it (or into the last node, if there is no such node)
+   UNode *cursor = headPtr;
+   while (cursor->link != 0 && cursor->data[cursor->count - 1] < value)
+      cursor = cursor->link;
+
+   if (cursor->count == UNODE_CAPACITY)
+   {
+      SplitUNode(cursor);
+      if (cursor->data[cursor->count - 1] < value)
+         cursor = cursor->link;
+   }
+
+   int pos = 0;
+   while (pos < cursor->count && cursor->data[pos] < value)
+      ++pos;
+   InsertAt(cursor, pos, value);
+}
+
+bool DelFirstTargetNode(UNode*& headPtr, int target)
+{
+   UNode *precursor = 0,
+         *cursor = headPtr;
+   int pos = 0;
+
+   while (cursor != 0)
+   {
+      for (pos = 0; pos < cursor->count && cursor->data[pos] != target; ++pos)
+         ;
+      if (pos < cursor->count)
+         break;
+      precursor = cursor;
+      cursor = cursor->link;
+   }
+   if (cursor == 0)
+   {
+      cout << target << " not found." << endl;
+      return false;
+   }
+
+   --cursor->count;
+   memmove(cursor->data + pos, cursor->data + pos + 1,
+           (cursor->count - pos) * sizeof(int));
+
+   if (cursor->count == 0)
+   {
+      // No node is left empty
+      if (cursor == headPtr) //OR precursor == 0
+         headPtr = headPtr->link;
+      else
+         precursor->link = cursor->link;
+      delete cursor;
+   }
+   else if (cursor->count < UNODE_CAPACITY / 2 && cursor->link != 0
+            && cursor->count + cursor->link->count <= UNODE_CAPACITY)
+   {
+      // Keep nodes at least about half full by taking in the next node
+      UNode *next = cursor->link;
+      memcpy(cursor->data + cursor->count, next->data,
+             next->count * sizeof(int));
+      cursor->count += next->count;
+      cursor->link = next->link;
+      delete next;
+   }
+   return true;
+}
+
+void ShowAll(ostream& outs, UNode* headPtr)
+{
+   while (headPtr != 0)
+   {
+      for (int i = 0; i < headPtr->count; ++i)
+         outs << headPtr->data[i] << "  ";
+      headPtr = headPtr->link;
+   }
+   outs << endl;
+}
+
+void FindMinMax(UNode* headPtr, int& minValue, int& maxValue)
+{
+   if (headPtr == 0)
+   {
+      cerr << "FindMinMax() attempted on empty list" << endl;
+      cerr << "Minimum and maximum values not set" << endl;
+   }
+   else
+   {
+      int low = headPtr->data[0],
+          high = headPtr->data[0];
+      while (headPtr != 0)
+      {
+         // Branch-free updates over a node's array
+         for (int i = 0; i < headPtr->count; ++i)
+         {
+            low = (headPtr->data[i] < low) ? headPtr->data[i] : low;
+            high = (headPtr->data[i] > high) ? headPtr->data[i] : high;
+         }
+         headPtr = headPtr->link;
+      }
+      minValue = low;
+      maxValue = high;
+   }
+}
+
+double FindAverage(UNode* headPtr)
+{
+   if (headPtr == 0)
+   {
+      cerr << "FindAverage() attempted on empty list" << endl;
+      cerr << "An arbitrary zero value is returned" << endl;
+      return 0.0;
+   }
+   else
+   {
+      long long sum = 0;
+      int count = 0;
+
+      while (headPtr != 0)
+      {
+         count += headPtr->count;
+         for (int i = 0; i < headPtr->count; ++i)
+            sum += headPtr->data[i];
+         headPtr = headPtr->link;
+      }
+
+      return double(sum) / count;
+   }
+}
+
+void ListClear(UNode*& headPtr, int noMsg)
+{
+   int count = 0;
+
+   UNode *cursor = headPtr;
+   while (headPtr != 0)
+   {
+      headPtr = headPtr->link;
+      delete cursor;
+      cursor = headPtr;
+      ++count;
+   }
+   if (noMsg) return;
+   clog << "Dynamic memory for " << count << " nodes freed"
+        << endl;
+}
@@ -0,0 +1,33 @@
+#ifndef ULLCP_INT_H
+#define ULLCP_INT_H
+
+#include <iostream>
+
+// An unrolled version of the llcpInt toolkit: each UNode holds up to
+// UNODE_CAPACITY ints (data[0] through data[count-1], in list order)
+// instead of one, so a traversal follows one link (and touches one
+// 64-byte cache line) per UNODE_CAPACITY items instead of per item.
+// A list is a UNode* head pointer as before; no node in a list is
+// empty. The functions are overloads of (and behave like) the llcpInt.h
+// functions of the same names, with items in place of nodes.
+const int UNODE_CAPACITY = 13;
+
+struct UNode
+{
+   UNode *link;
+   int    count;
+   int    data[UNODE_CAPACITY];
+};
+
+int    FindListLength(UNode* headPtr);
+bool   IsSortedUp(UNode* headPtr);
+void   InsertAsHead(UNode*& headPtr, int value);
+void   InsertAsTail(UNode*& headPtr, int value);
+void   InsertSortedUp(UNode*& headPtr, int value);
+bool   DelFirstTargetNode(UNode*& headPtr, int target);
+void   ShowAll(std::ostream& outs, UNode* headPtr);
+void   FindMinMax(UNode* headPtr, int& minValue, int& maxValue);
+double FindAverage(UNode* headPtr);
+void   ListClear(UNode*& headPtr, int noMsg = 0);
+
+#endif
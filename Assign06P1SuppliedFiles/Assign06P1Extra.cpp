@@ -0,0 +1,277 @@
+#include "llcpInt.h"
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+using namespace std;
+
+void SeedRand();
+int  BoundedRandomInt(int lowerBound, int upperBound);
+bool match(Node* head, const int procInts[], int procSize);
+void ShowArray(const int a[], int size);
+void InsertSortedNonDec(int array[], int& used, int newValue);
+bool FromList(Node* node, Node* const nodes[], int size);
+bool TestSortedMerge(int testCasesToDo);
+bool TestSortList(int testCasesToDo);
+bool TestParallelSortList(int length, int threadCount);
+
+int main()
+{
+   const int LONG_LIST = 5 * (1 << 16) + 123;
+
+   // SeedRand(); // disabled for reproducible result
+
+   cout << "================================" << endl;
+   if ( !TestSortedMerge(100000) ||
+        !TestSortList(100000) ||
+        !TestParallelSortList(1000, 4) ||
+        !TestParallelSortList(LONG_LIST, 2) ||
+        !TestParallelSortList(LONG_LIST, 3) ||
+        !TestParallelSortList(LONG_LIST, 5) ||
+        !TestParallelSortList(LONG_LIST, 0) )
+      exit(EXIT_FAILURE);
+   cout << "================================" << endl;
+   cout << "test program terminated normally" << endl;
+   cout << "================================" << endl;
+
+   return EXIT_SUCCESS;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Function to test SortedMerge on lists with long runs
+// POST: Pairs of sorted up lists, long enough for SortedMerge to
+//       gallop over runs, have been merged and checked against the
+//       values sorted into an array; equal values must keep the nodes
+//       of X in front of those of Y. The return value is true if every
+//       check passed.
+/////////////////////////////////////////////////////////////////////
+bool TestSortedMerge(int testCasesToDo)
+{
+   const int loSize = 0,
+             hiSize = 60,
+             loValue = -9,
+             hiValue = 9;
+   int intArr1[hiSize],
+       intArr2[hiSize],
+       intArr3[2 * hiSize];
+   Node *xNodes[hiSize];
+   Node *headX = 0,
+        *headY = 0,
+        *headZ = 0;
+
+   for (int testCasesDone = 1; testCasesDone <= testCasesToDo; ++testCasesDone)
+   {
+      int used1 = 0,
+          used2 = 0,
+          used3 = 0,
+          size1 = BoundedRandomInt(loSize, hiSize),
+          size2 = BoundedRandomInt(loSize, hiSize);
+      // different value ranges for X and Y give long runs from one list
+      int hi1 = BoundedRandomInt(loValue, hiValue),
+          hi2 = BoundedRandomInt(loValue, hiValue);
+      for (int intCount = 0; intCount < size1; ++intCount)
+         InsertSortedNonDec(intArr1, used1, BoundedRandomInt(loValue, hi1));
+      for (int intCount = 0; intCount < size2; ++intCount)
+         InsertSortedNonDec(intArr2, used2, BoundedRandomInt(loValue, hi2));
+      for (int i = 0; i < used1; ++i)
+      {
+         InsertSortedNonDec(intArr3, used3, intArr1[i]);
+         InsertAsTail(headX, intArr1[i]);
+      }
+      for (int i = 0; i < used2; ++i)
+      {
+         InsertSortedNonDec(intArr3, used3, intArr2[i]);
+         InsertAsTail(headY, intArr2[i]);
+      }
+      Node *cursor = headX;
+      for (int i = 0; i < used1; ++i, cursor = cursor->link)
+         xNodes[i] = cursor;
+
+      SortedMerge(headX, headY, headZ);
+
+      bool ok = (headX == 0 && headY == 0 &&
+                 FindListLength(headZ) == used3 &&
+                 match(headZ, intArr3, used3));
+      for (cursor = headZ; ok && cursor != 0 && cursor->link != 0;
+           cursor = cursor->link)
+         if (cursor->data == cursor->link->data &&
+             !FromList(cursor, xNodes, used1) &&
+             FromList(cursor->link, xNodes, used1))
+            ok = false;
+      if (!ok)
+      {
+         cout << "SortedMerge contents error in test case "
+              << testCasesDone << endl;
+         cout << "X: ";
+         ShowArray(intArr1, used1);
+         cout << "Y: ";
+         ShowArray(intArr2, used2);
+         cout << "ought2b: ";
+         ShowArray(intArr3, used3);
+         cout << "outcome: ";
+         ShowAll(cout, headZ);
+         return false;
+      }
+      ListClear(headZ, 1);
+   }
+   cout << "passed SortedMerge tests" << endl;
+   return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Function to test SortList on short random lists
+// POST: Each list has been sorted by SortList and checked against the
+//       same values sorted into an array; the return value is true if
+//       every check passed.
+/////////////////////////////////////////////////////////////////////
+bool TestSortList(int testCasesToDo)
+{
+   const int loSize = 0,
+             hiSize = 40,
+             loValue = -9,
+             hiValue = 9;
+   int intArr0[hiSize],
+       intArr1[hiSize];
+   Node *head = 0;
+
+   for (int testCasesDone = 1; testCasesDone <= testCasesToDo; ++testCasesDone)
+   {
+      int used0 = BoundedRandomInt(loSize, hiSize),
+          used1 = 0;
+      for (int intCount = 0; intCount < used0; ++intCount)
+      {
+         intArr0[intCount] = BoundedRandomInt(loValue, hiValue);
+         InsertSortedNonDec(intArr1, used1, intArr0[intCount]);
+         InsertAsTail(head, intArr0[intCount]);
+      }
+
+      SortList(head);
+      if ( FindListLength(head) != used1 || !match(head, intArr1, used1) )
+      {
+         cout << "SortList contents error in test case "
+              << testCasesDone << endl;
+         cout << "initial: ";
+         ShowArray(intArr0, used0);
+         cout << "ought2b: ";
+         ShowArray(intArr1, used1);
+         cout << "outcome: ";
+         ShowAll(cout, head);
+         return false;
+      }
+      ListClear(head, 1);
+   }
+   cout << "passed SortList tests" << endl;
+   return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Function to test ParallelSortList on one long random list
+// POST: A list of length random values has been sorted with
+//       threadCount threads and checked to hold the same values, each
+//       as often as before, in ascending order; the return value is
+//       true if every check passed.
+/////////////////////////////////////////////////////////////////////
+bool TestParallelSortList(int length, int threadCount)
+{
+   const int loValue = -1000,
+             hiValue = 1000;
+   int counts[hiValue - loValue + 1] = { 0 };
+   Node *head = 0,
+        *tail = 0;
+
+   for (int intCount = 0; intCount < length; ++intCount)
+   {
+      int newInt = BoundedRandomInt(loValue, hiValue);
+      ++counts[newInt - loValue];
+      // append through tail, since InsertAsTail walks the whole list
+      if (tail == 0)
+      {
+         InsertAsHead(head, newInt);
+         tail = head;
+      }
+      else
+      {
+         InsertAsHead(tail->link, newInt);
+         tail = tail->link;
+      }
+   }
+
+   ParallelSortList(head, threadCount);
+
+   bool ok = IsSortedUp(head);
+   for (Node *cursor = head; ok && cursor != 0; cursor = cursor->link)
+      ok = (--counts[cursor->data - loValue] >= 0);
+   for (int i = 0; ok && i <= hiValue - loValue; ++i)
+      ok = (counts[i] == 0);
+   ListClear(head, 1);
+   if (!ok)
+   {
+      cout << "ParallelSortList error sorting " << length
+           << " nodes with threadCount " << threadCount << endl;
+      return false;
+   }
+   cout << "passed ParallelSortList test (" << length << " nodes, "
+        << "threadCount " << threadCount << ")" << endl;
+   return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Function to seed the random number generator
+// PRE:  none
+// POST: The random number generator has been seeded.
+/////////////////////////////////////////////////////////////////////
+void SeedRand()
+{
+   srand( (unsigned) time(NULL) );
+}
+
+/////////////////////////////////////////////////////////////////////
+// Function to generate a random integer between
+// lowerBound and upperBound (inclusive)
+// PRE:  upperBound is not less than lowerBound
+//       The random number generator has been seeded.
+// POST: A random integer between lowerBound and upperBound
+//       has been returned.
+/////////////////////////////////////////////////////////////////////
+int BoundedRandomInt(int lowerBound, int upperBound)
+{
+   return ( rand() % (upperBound - lowerBound + 1) ) + lowerBound;
+}
+
+bool match(Node* head, const int procInts[], int procSize)
+{
+   int iProc = 0;
+   while (head != 0)
+   {
+      if (iProc == procSize) return false;
+      if (head->data != procInts[iProc]) return false;
+      ++iProc;
+      head = head->link;
+   }
+   return true;
+}
+
+void ShowArray(const int a[], int size)
+{
+   for (int i = 0; i < size; ++i)
+      cout << a[i] << "  ";
+   cout << endl;
+}
+
+void InsertSortedNonDec(int array[], int& used, int newValue)
+{
+   int probeIndex = used;
+   while (probeIndex > 0 && array[probeIndex - 1] > newValue)
+   {
+      array[probeIndex] = array[probeIndex - 1];
+      --probeIndex;
+   }
+   array[probeIndex] = newValue;
+   ++used;
+}
+
+bool FromList(Node* node, Node* const nodes[], int size)
+{
+   for (int i = 0; i < size; ++i)
+      if (nodes[i] == node) return true;
+   return false;
+}
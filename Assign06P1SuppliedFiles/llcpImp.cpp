@@ -5,46 +5,240 @@
 
 #include <iostream>
 #include <cstdlib>
+#include <thread>   // provides std::thread
+#include <vector>   // provides std::vector
 #include "llcpInt.h"
 using namespace std;
 
-void SortedMergeRecur (Node*& xNode, Node*& yNode, Node*& zNode)
+// Merges the ascending lists X and Y into Z by relinking their nodes
+// (no nodes are created or deleted); X and Y are left empty. Ties take
+// X's node first, so the merge is stable. A tail pointer (zTail, the
+// link the next node goes into) replaces the recursion, so the merge
+// uses constant stack space for lists of any length.
+void SortedMerge(Node*& xNode, Node*& yNode, Node*& zNode)
 {
-   // If X and Y lists are empty, do nothing
-   if (!xNode && !yNode) return;
+   // After this many nodes in a row from the same list, the rest of
+   // that list's run is passed over in one go
+   const int GALLOP_AFTER = 7;
 
-   if (xNode && !yNode) 
+   Node **zTail = &zNode;
+   bool lastFromY = false;
+   int streak = 0;
+
+   while (xNode != 0 && yNode != 0)
    {
-      // If Y list is empty but X is not
-      // Move X nodes into Z list.
-      zNode = xNode;
-      xNode = xNode->link;
+      // Choose the source by selecting a pointer rather than branching
+      // to two copies of the linking code
+      bool fromY = yNode->data < xNode->data;
+      Node **source = fromY ? &yNode : &xNode;
+      Node *taken = *source;
+      *zTail = taken;
+      zTail = &taken->link;
+      *source = taken->link;
+
+      streak = (fromY == lastFromY) ? streak + 1 : 1;
+      lastFromY = fromY;
+      if (streak >= GALLOP_AFTER && *source != 0)
+      {
+         // Gallop: the nodes following taken are already linked to it,
+         // so the whole run that still comes before the other list's
+         // first node joins Z without rewriting any links
+         const int otherFirst = fromY ? xNode->data : yNode->data;
+         Node *runEnd = taken,
+              *cursor = *source;
+         if (fromY)
+            while (cursor != 0 && cursor->data < otherFirst)
+            {
+               runEnd = cursor;
+               cursor = cursor->link;
+            }
+         else
+            while (cursor != 0 && cursor->data <= otherFirst)
+            {
+               runEnd = cursor;
+               cursor = cursor->link;
+            }
+         zTail = &runEnd->link;
+         *source = cursor;
+         streak = 0;
+      }
    }
-   else if (!xNode && yNode)
+
+   // Whatever remains of one list follows in its existing order
+   *zTail = (xNode != 0) ? xNode : yNode;
+   xNode = yNode = 0;
+}
+
+namespace
+{
+   // Detaches the run of nodes at the front of headPtr that is already
+   // in order and returns it (ascending); headPtr is left at the node
+   // after the run. A strictly descending run is reversed as it is
+   // detached (strictly, so equal items never change order).
+   Node* CutRun(Node*& headPtr)
    {
-      // If X list is empty but Y is not
-      // Move Y nodes into Z list.
-      zNode = yNode;
-      yNode = yNode->link;
-      zNode->link = 0;
+      Node *run = headPtr,
+           *cursor = headPtr->link;
+
+      if (cursor != 0 && cursor->data < run->data)
+      {
+         run->link = 0;
+         while (cursor != 0 && cursor->data < run->data)
+         {
+            Node *next = cursor->link;
+            cursor->link = run;
+            run = cursor;
+            cursor = next;
+         }
+         headPtr = cursor;
+         return run;
+      }
+
+      Node *last = run;
+      while (cursor != 0 && cursor->data >= last->data)
+      {
+         last = cursor;
+         cursor = cursor->link;
+      }
+      last->link = 0;
+      headPtr = cursor;
+      return run;
    }
-   else if ((xNode && yNode) && (xNode->data <= yNode->data))
+}
+
+// Sorts the list into ascending order by relinking its nodes (a stable
+// bottom-up natural merge sort). The runs already in the list are merged
+// pairwise, binary-counter fashion: pending[i] holds a merge of about
+// 2^i runs, so only O(log n) lists wait at once and a fixed array holds
+// them (no memory is allocated). Input that is already sorted (or
+// strictly descending) is a single run, which takes one pass.
+void SortList(Node*& headPtr)
+{
+   const int MAX_LEVELS = 64;
+   Node *pending[MAX_LEVELS] = { 0 };
+   int levels = 0;
+
+   while (headPtr != 0)
    {
-      // If X and Y have nodes compare their values
-      // Add X's node to Z if its smaller
-      zNode = xNode;
-      xNode = xNode->link;
+      Node *carry = CutRun(headPtr);
+      int i = 0;
+      // Lists at lower levels hold later runs, so they go in as Y (the
+      // second list) to keep the merge stable
+      while (i < levels && pending[i] != 0)
+      {
+         Node *merged = 0;
+         SortedMerge(pending[i], carry, merged);
+         carry = merged;
+         ++i;
+      }
+      if (i == levels && levels < MAX_LEVELS)
+         ++levels;
+      pending[i] = carry;
    }
-   else
+
+   // Combine what is left, newest (lowest level) first
+   Node *sorted = 0;
+   for (int i = 0; i < levels; ++i)
+      if (pending[i] != 0)
+      {
+         Node *merged = 0;
+         SortedMerge(pending[i], sorted, merged);
+         sorted = merged;
+      }
+   headPtr = sorted;
+}
+
+namespace
+{
+   // Starts task on a new thread added to workers, or, if no thread can
+   // be started (std::thread throws, e.g. with EAGAIN), runs it on the
+   // calling thread instead. workers must have room reserved for the
+   // new thread, so that adding it cannot throw once it is running.
+   template <class Task>
+   void StartOrRun(std::vector<std::thread>& workers, Task task)
    {
-      // Add Y's node to Z if its smaller
-      zNode = yNode;
-      yNode = yNode->link;
-      zNode->link = 0;
+      try
+      {
+         workers.push_back(std::thread(task));
+      }
+      catch (...)
+      {
+         task();
+      }
    }
+}
+
+// Sorts the list like SortList, using up to threadCount threads (0 means
+// one per hardware thread). The list is cut into one segment per
+// thread, the segments are sorted at the same time, and then merged
+// pairwise in rounds, each round's merges running at the same time.
+// Cutting the list and the last merge are single passes that only one
+// thread can do. Lists too short to be worth a thread per
+// PARALLEL_CUTOFF nodes use fewer threads (or just SortList).
+void ParallelSortList(Node*& headPtr, int threadCount)
+{
+   const int PARALLEL_CUTOFF = 1 << 16;
 
-   // Call SortedMergeRecur to iterate through the listsx
-   SortedMergeRecur (xNode, yNode, zNode->link);
+   if (threadCount <= 0)
+      threadCount = std::thread::hardware_concurrency();
+   int length = FindListLength(headPtr);
+   if (threadCount > length / PARALLEL_CUTOFF)
+      threadCount = length / PARALLEL_CUTOFF;
+   if (threadCount < 2)
+   {
+      SortList(headPtr);
+      return;
+   }
+
+   // Cut the list into threadCount segments of (nearly) equal length
+   std::vector<Node*> segments(threadCount);
+   Node *cursor = headPtr;
+   for (int i = 0; i < threadCount; ++i)
+   {
+      int segmentLength = length / threadCount
+                          + (i < length % threadCount ? 1 : 0);
+      segments[i] = cursor;
+      for (int k = 1; k < segmentLength; ++k)
+         cursor = cursor->link;
+      Node *next = cursor->link;
+      cursor->link = 0;
+      cursor = next;
+   }
+
+   // A segment whose thread can't be started is sorted right here, so
+   // the list is always sorted in full (just with fewer threads)
+   std::vector<std::thread> workers;
+   workers.reserve(threadCount);
+   for (int i = 1; i < threadCount; ++i)
+      StartOrRun(workers, [&segments, i] { SortList(segments[i]); });
+   SortList(segments[0]);
+   for (size_t t = 0; t < workers.size(); ++t)
+      workers[t].join();
+
+   // Merge neighbouring segments (earlier one first, for stability),
+   // doubling the distance between the survivors each round
+   for (int width = 1; width < threadCount; width *= 2)
+   {
+      workers.clear();
+      for (int i = 0; i + width < threadCount; i += 2 * width)
+         StartOrRun(workers, [&segments, i, width]
+         {
+            Node *merged = 0;
+            SortedMerge(segments[i], segments[i + width], merged);
+            segments[i] = merged;
+         });
+      for (size_t t = 0; t < workers.size(); ++t)
+         workers[t].join();
+   }
+   headPtr = segments[0];
+}
+
+// SortedMergeRecur keeps its original name for existing callers; it
+// merges with SortedMerge, since recursing once per node overflows the
+// stack on long lists
+void SortedMergeRecur(Node*& xNode, Node*& yNode, Node*& zNode)
+{
+   SortedMerge(xNode, yNode, zNode);
 }
 
 int FindListLength(Node* headPtr)
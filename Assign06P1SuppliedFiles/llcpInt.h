@@ -20,6 +20,9 @@ void   ShowAll(std::ostream& outs, Node* headPtr);
 void   FindMinMax(Node* headPtr, int& minValue, int& maxValue);
 double FindAverage(Node* headPtr);
 void   ListClear(Node*& headPtr, int noMsg = 0);
+void   SortedMerge(Node*& xNode, Node*& yNode, Node*& zNode);
 void   SortedMergeRecur(Node*& xNode, Node*& yNode, Node*& zNode);
+void   SortList(Node*& headPtr);
+void   ParallelSortList(Node*& headPtr, int threadCount = 0);
 
 #endif